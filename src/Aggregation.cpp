@@ -0,0 +1,152 @@
+#include "Aggregation.h"
+#include "Feasibility.h"
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+namespace {
+
+// Demandas de sinais opostos não podem dividir um grupo (a carga interna deixaria de ser monótona)
+bool CompatibleSign(long long a, long long b) {
+    return !((a > 0 && b < 0) || (a < 0 && b > 0));
+}
+
+// Ordem interna: cadeia do vizinho mais próximo a partir de cada membro, a mais barata
+std::vector<int> InternalOrder(const Data& data, const std::vector<int>& group, double& cost) {
+    std::vector<int> best;
+    cost = std::numeric_limits<double>::infinity();
+    for (size_t start = 0; start < group.size(); ++start) {
+        std::vector<char> used(group.size(), 0);
+        std::vector<int> order{group[start]};
+        used[start] = 1;
+        double total = 0.0;
+        for (size_t step = 1; step < group.size(); ++step) {
+            size_t next = 0;
+            double next_cost = std::numeric_limits<double>::infinity();
+            for (size_t k = 0; k < group.size(); ++k) {
+                double c = data.getTravelCost(order.back(), group[k]);
+                if (!used[k] && c < next_cost) {
+                    next = k;
+                    next_cost = c;
+                }
+            }
+            used[next] = 1;
+            order.push_back(group[next]);
+            total += next_cost;
+        }
+        if (total < cost) {
+            cost = total;
+            best = std::move(order);
+        }
+    }
+    return best;
+}
+
+} // namespace
+
+Aggregation AggregateStations(const Data& data, double threshold) {
+    const int n = data.getNumStations();
+    const long long Q = static_cast<long long>(data.getVehicleCapacity());
+
+    Aggregation aggregation;
+    aggregation.members.push_back({0});
+    aggregation.node_of.assign(n + 1, -1);
+    aggregation.node_of[0] = 0;
+
+    // Grupos gulosos na ordem dos ids; candidatos vêm da lista de vizinhos (ordenada por custo),
+    // e uma estação só entra se estiver a <= threshold de todos os membros, nos dois sentidos
+    std::vector<double> internal_cost{0.0};
+    bool merged = false;
+    for (int i = 1; i <= n; ++i) {
+        if (aggregation.node_of[i] >= 0) continue;
+        const int node = static_cast<int>(aggregation.members.size());
+        std::vector<int> group{i};
+        aggregation.node_of[i] = node;
+        long long total = NodeDemand(data, i);
+
+        for (int j : data.getNeighbors(i)) {
+            if (data.getTravelCost(i, j) > threshold) break;
+            long long demand = NodeDemand(data, j);
+            if (aggregation.node_of[j] >= 0 || std::llabs(total + demand) > Q) continue;
+            bool fits = true;
+            for (int m : group) {
+                if (!CompatibleSign(NodeDemand(data, m), demand) || data.getTravelCost(m, j) > threshold ||
+                    data.getTravelCost(j, m) > threshold) {
+                    fits = false;
+                    break;
+                }
+            }
+            if (!fits) continue;
+            group.push_back(j);
+            aggregation.node_of[j] = node;
+            total += demand;
+        }
+
+        double cost = 0.0;
+        if (group.size() > 1) {
+            group = InternalOrder(data, group, cost);
+            merged = true;
+        }
+        aggregation.members.push_back(std::move(group));
+        internal_cost.push_back(cost);
+    }
+    if (!merged) {
+        return aggregation;
+    }
+
+    // Arco A -> X = sequência interna de A + último de A -> primeiro de X (X = 0 volta ao depósito)
+    const int k = static_cast<int>(aggregation.members.size()) - 1;
+    std::vector<long long> demands(k);
+    for (int a = 1; a <= k; ++a) {
+        for (int v : aggregation.members[a]) {
+            demands[a - 1] += NodeDemand(data, v);
+        }
+    }
+    std::vector<double> costs(static_cast<size_t>(k + 1) * (k + 1), 0.0);
+    for (int a = 0; a <= k; ++a) {
+        int last = aggregation.members[a].back();
+        for (int x = 0; x <= k; ++x) {
+            if (a == x) continue;
+            costs[static_cast<size_t>(a) * (k + 1) + x] =
+                internal_cost[a] + data.getTravelCost(last, aggregation.members[x].front());
+        }
+    }
+    aggregation.reduced = std::make_unique<Data>(data.getInstanceName(), k, data.getNumVehicles(),
+                                                 data.getVehicleCapacity(), demands, costs);
+    return aggregation;
+}
+
+Solution ExpandSolution(const Data& data, const Aggregation& aggregation, const Solution& reduced) {
+    Solution expanded;
+    for (const Route& route : reduced.routes) {
+        Route full;
+        full.nodes.push_back(0);
+        for (size_t i = 1; i + 1 < route.nodes.size(); ++i) {
+            const std::vector<int>& members = aggregation.members[route.nodes[i]];
+            full.nodes.insert(full.nodes.end(), members.begin(), members.end());
+        }
+        full.nodes.push_back(0);
+        expanded.routes.push_back(std::move(full));
+    }
+    expanded.total_cost = SolutionCost(data, expanded);
+    return expanded;
+}
+
+Solution ContractSolution(const Aggregation& aggregation, const Solution& solution) {
+    std::vector<char> placed(aggregation.members.size(), 0);
+    Solution contracted;
+    for (const Route& route : solution.routes) {
+        Route reduced;
+        reduced.nodes.push_back(0);
+        for (size_t i = 1; i + 1 < route.nodes.size(); ++i) {
+            int node = aggregation.node_of[route.nodes[i]];
+            if (!placed[node]) {
+                placed[node] = 1;
+                reduced.nodes.push_back(node);
+            }
+        }
+        reduced.nodes.push_back(0);
+        contracted.routes.push_back(std::move(reduced));
+    }
+    return contracted;
+}
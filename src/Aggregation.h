@@ -0,0 +1,32 @@
+#ifndef AGGREGATION_H
+#define AGGREGATION_H
+
+#include <memory>
+#include <vector>
+#include "Construction.h"
+#include "Instance.h"
+
+// Agregação de estações quase coincidentes (custo <= limiar nos dois sentidos entre todos os
+// pares do grupo) em super-nós. Só entram no mesmo grupo estações de demandas do mesmo sinal
+// (ou zero): a carga ao longo da sequência interna é monótona, então a janela de carga do
+// super-nó é a de uma estação com a demanda total, e qualquer rota viável na instância
+// reduzida continua viável expandida (|total| <= Q é exigido ao formar o grupo). A sequência
+// interna é fixa; o custo dela entra nos arcos de saída do super-nó, então o custo de uma
+// rota reduzida é exatamente o da rota expandida.
+struct Aggregation {
+    // members[a] = estações (ids de `data`) do nó a da instância reduzida, na ordem interna;
+    // members[0] = {0} (depósito)
+    std::vector<std::vector<int>> members;
+    std::vector<int> node_of;          // node_of[v] = nó reduzido que contém a estação v
+    std::unique_ptr<Data> reduced;     // nullptr se nenhum par foi agregado
+};
+
+[[nodiscard]] Aggregation AggregateStations(const Data& data, double threshold);
+
+// Solução da instância reduzida -> instância original (custo recalculado)
+[[nodiscard]] Solution ExpandSolution(const Data& data, const Aggregation& aggregation, const Solution& reduced);
+// Solução da instância original -> reduzida: cada super-nó fica na posição do seu primeiro
+// membro visitado (para o warm start, que repara o que ficar inviável)
+[[nodiscard]] Solution ContractSolution(const Aggregation& aggregation, const Solution& solution);
+
+#endif
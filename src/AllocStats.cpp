@@ -0,0 +1,89 @@
+#include "AllocStats.h"
+
+#ifdef JPBIKE_ALLOC_STATS
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+thread_local unsigned long long thread_allocations = 0;
+thread_local unsigned long long thread_bytes = 0;
+std::atomic<unsigned long long> process_allocations{0};
+std::atomic<unsigned long long> process_bytes{0};
+
+void Count(std::size_t size) {
+    thread_allocations++;
+    thread_bytes += size;
+    process_allocations.fetch_add(1, std::memory_order_relaxed);
+    process_bytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+void* Allocate(std::size_t size) noexcept {
+    Count(size);
+    return std::malloc(size ? size : 1);
+}
+
+void* AllocateAligned(std::size_t size, std::align_val_t align) noexcept {
+    Count(size);
+    std::size_t alignment = static_cast<std::size_t>(align);
+    // aligned_alloc exige tamanho múltiplo do alinhamento
+    std::size_t rounded = (size + alignment - 1) / alignment * alignment;
+    return std::aligned_alloc(alignment, rounded ? rounded : alignment);
+}
+
+void* OrThrow(void* p) {
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+} // namespace
+
+void* operator new(std::size_t size) { return OrThrow(Allocate(size)); }
+void* operator new[](std::size_t size) { return OrThrow(Allocate(size)); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return Allocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return Allocate(size); }
+void* operator new(std::size_t size, std::align_val_t align) { return OrThrow(AllocateAligned(size, align)); }
+void* operator new[](std::size_t size, std::align_val_t align) { return OrThrow(AllocateAligned(size, align)); }
+void* operator new(std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return AllocateAligned(size, align);
+}
+void* operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return AllocateAligned(size, align);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
+
+AllocCounts ThreadAllocCounts() {
+    return {thread_allocations, thread_bytes};
+}
+
+AllocCounts ProcessAllocCounts() {
+    return {process_allocations.load(std::memory_order_relaxed), process_bytes.load(std::memory_order_relaxed)};
+}
+
+#else
+
+AllocCounts ThreadAllocCounts() {
+    return {};
+}
+
+AllocCounts ProcessAllocCounts() {
+    return {};
+}
+
+#endif
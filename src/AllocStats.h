@@ -0,0 +1,35 @@
+#ifndef ALLOC_STATS_H
+#define ALLOC_STATS_H
+
+// Contagem de alocações no heap. Só ativa quando compilado com JPBIKE_ALLOC_STATS
+// (make ALLOC_STATS=1): AllocStats.cpp substitui os operator new/delete globais e soma
+// chamadas e bytes pedidos, por thread e no processo. Sem a flag, as contagens são zero e
+// nenhum custo é adicionado às alocações.
+
+#ifdef JPBIKE_ALLOC_STATS
+constexpr bool kAllocStatsEnabled = true;
+#else
+constexpr bool kAllocStatsEnabled = false;
+#endif
+
+struct AllocCounts {
+    unsigned long long allocations = 0;
+    unsigned long long bytes = 0;
+
+    AllocCounts& operator+=(const AllocCounts& other) {
+        allocations += other.allocations;
+        bytes += other.bytes;
+        return *this;
+    }
+};
+
+inline AllocCounts operator-(const AllocCounts& a, const AllocCounts& b) {
+    return {a.allocations - b.allocations, a.bytes - b.bytes};
+}
+
+// Alocações feitas pela thread atual desde que ela começou (diferenças medem um trecho)
+[[nodiscard]] AllocCounts ThreadAllocCounts();
+// Alocações de todas as threads desde o início do processo
+[[nodiscard]] AllocCounts ProcessAllocCounts();
+
+#endif
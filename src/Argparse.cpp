@@ -7,19 +7,43 @@ void PrintUsage(const char* program_name) {
     std::cout << "Opções:" << std::endl;
     std::cout << "  --instance PATH       Caminho para arquivo da instância (obrigatório)" << std::endl;
     std::cout << "  --seed N             Semente para números aleatórios (padrão: 42)" << std::endl;
-    std::cout << "  --constructive TIPO  Método construtivo: 'nearest' ou 'insertion' (padrão: nearest)" << std::endl;
+    std::cout << "  --constructive TIPO  Método construtivo: 'nearest', 'insertion' ou 'savings' (padrão: nearest)" << std::endl;
     std::cout << "  --no-vnd             Desabilita VND, usa apenas heurística construtiva" << std::endl;
     std::cout << "  --out DIR            Diretório de saída (padrão: outputs/)" << std::endl;
     std::cout << "  --feastest           Executa testes de viabilidade" << std::endl;
     std::cout << "  --verbose            Exibe saída detalhada" << std::endl;
+    std::cout << "  --renumber           Renumera as estações por localidade antes de resolver (saída mantém os ids originais)" << std::endl;
+    std::cout << "  --shm                Matriz em memória compartilhada: processos com a mesma instância usam uma cópia" << std::endl;
+    std::cout << "  --warm-start FILE    Parte de um .out anterior, reparando rotas inviáveis com as novas demandas" << std::endl;
+    std::cout << "  --trace FILE         Grava melhorias e tempos por fase em JSON lines" << std::endl;
+    std::cout << "  --verify P           Confere uma fração P dos movimentos aceitos (custo e viabilidade); aborta na divergência" << std::endl;
     std::cout << "" << std::endl;
     std::cout << "Opções ILS:" << std::endl;
     std::cout << "  --ils                Executa metaheurística ILS (Iterated Local Search)" << std::endl;
     std::cout << "  --max-iter N         Número de iterações externas do ILS (padrão: 50)" << std::endl;
-    std::cout << "  --max-iter-ils N     Iterações sem melhoria antes de re-iniciar (padrão: 150)" << std::endl;
+    std::cout << "  --max-iter-ils N     Iterações sem melhoria antes de re-iniciar (padrão: 100)" << std::endl;
     std::cout << "  --rcl-alpha-min F    Limite inferior para GRASP α (padrão: 0.1)" << std::endl;
     std::cout << "  --rcl-alpha-max F    Limite superior para GRASP α (padrão: 0.5)" << std::endl;
     std::cout << "  --perturb-strength K Intensidade base para perturbação (padrão: 2)" << std::endl;
+    std::cout << "  --time-limit S       Limite de tempo do ILS em segundos (padrão: sem limite)" << std::endl;
+    std::cout << "  --threads N          Modo determinístico: reinícios em N threads, um fluxo aleatório por reinício" << std::endl;
+    std::cout << "  --batch B            Reinícios por rodada no modo determinístico (padrão: 8)" << std::endl;
+    std::cout << "  --grasp-threads N    Avalia os candidatos de cada passo do GRASP em N threads (padrão: 1)" << std::endl;
+    std::cout << "  --elite N            Conjunto elite com N soluções e path relinking (padrão: 0, desligado)" << std::endl;
+    std::cout << "  --relink-every K     Path relinking no lugar do reinício a cada K iterações (padrão: 5)" << std::endl;
+    std::cout << "  --relink-pairs P     Caminhos por rodada de path relinking (padrão: 3)" << std::endl;
+    std::cout << "  --penalized          Busca local após perturbação pode violar a capacidade (custo + λ·violação)" << std::endl;
+    std::cout << "  --resequence         RVND re-sequencia rotas de até 12 estações de forma exata (DP memoizada)" << std::endl;
+    std::cout << "  --oropt K            Or-opt intra-rota com trechos de 1 a K estações, também invertidos, no lugar do Or-opt-2" << std::endl;
+    std::cout << "  --decompose          Otimiza por subproblemas (rota semente + rotas vizinhas) com ILS; implica --ils" << std::endl;
+    std::cout << "  --decompose-size N   Estações por subproblema da decomposição (padrão: 100)" << std::endl;
+    std::cout << "  --aggregate T        Resolve com estações a custo <= T entre si (nos dois sentidos) agregadas" << std::endl;
+    std::cout << "  --penalty-target F   Fração alvo de ótimos locais viáveis para ajustar λ (padrão: 0.5)" << std::endl;
+    std::cout << "" << std::endl;
+    std::cout << "Modo daemon:" << std::endl;
+    std::cout << "  --daemon             Atende pedidos em stdin/stdout mantendo instâncias em cache" << std::endl;
+    std::cout << "  --socket PATH        Atende pedidos num socket Unix em PATH (implica --daemon)" << std::endl;
+    std::cout << "  --cache-size N       Instâncias mantidas em cache (padrão: 8)" << std::endl;
     std::cout << "  --help               Exibe esta ajuda" << std::endl;
 }
 
@@ -48,8 +72,9 @@ CLIOptions ParseCLI(int argc, char* argv[]) {
         else if (strcmp(argv[i], "--constructive") == 0) {
             if (i + 1 < argc) {
                 opts.constructive_method = argv[++i];
-                if (opts.constructive_method != "nearest" && opts.constructive_method != "insertion") {
-                    std::cout << "Erro: --constructive deve ser 'nearest' ou 'insertion'" << std::endl;
+                if (opts.constructive_method != "nearest" && opts.constructive_method != "insertion" &&
+                    opts.constructive_method != "savings") {
+                    std::cout << "Erro: --constructive deve ser 'nearest', 'insertion' ou 'savings'" << std::endl;
                     exit(1);
                 }
             } else {
@@ -80,6 +105,43 @@ CLIOptions ParseCLI(int argc, char* argv[]) {
         else if (strcmp(argv[i], "--verbose") == 0) {
             opts.verbose = true;
         }
+        else if (strcmp(argv[i], "--renumber") == 0) {
+            opts.renumber = true;
+        }
+        else if (strcmp(argv[i], "--shm") == 0) {
+            opts.shared_memory = true;
+        }
+        else if (strcmp(argv[i], "--warm-start") == 0) {
+            if (i + 1 < argc) {
+                opts.warm_start_path = argv[++i];
+            } else {
+                std::cout << "Erro: --warm-start requer um arquivo .out" << std::endl;
+                PrintUsage(argv[0]);
+                exit(1);
+            }
+        }
+        else if (strcmp(argv[i], "--trace") == 0) {
+            if (i + 1 < argc) {
+                opts.trace_path = argv[++i];
+            } else {
+                std::cout << "Erro: --trace requer um arquivo" << std::endl;
+                PrintUsage(argv[0]);
+                exit(1);
+            }
+        }
+        else if (strcmp(argv[i], "--verify") == 0) {
+            if (i + 1 < argc) {
+                opts.verify = std::stod(argv[++i]);
+                if (opts.verify <= 0.0 || opts.verify > 1.0) {
+                    std::cout << "Erro: --verify deve estar em (0, 1]" << std::endl;
+                    exit(1);
+                }
+            } else {
+                std::cout << "Erro: --verify requer uma probabilidade" << std::endl;
+                PrintUsage(argv[0]);
+                exit(1);
+            }
+        }
         else if (strcmp(argv[i], "--ils") == 0) {
             opts.use_ils = true;
         }
@@ -148,13 +210,193 @@ CLIOptions ParseCLI(int argc, char* argv[]) {
                 exit(1);
             }
         }
+        else if (strcmp(argv[i], "--time-limit") == 0) {
+            if (i + 1 < argc) {
+                opts.time_limit = std::stod(argv[++i]);
+                if (opts.time_limit < 0.0) {
+                    std::cout << "Erro: --time-limit não pode ser negativo" << std::endl;
+                    exit(1);
+                }
+            } else {
+                std::cout << "Erro: --time-limit requer um número" << std::endl;
+                PrintUsage(argv[0]);
+                exit(1);
+            }
+        }
+        else if (strcmp(argv[i], "--threads") == 0) {
+            if (i + 1 < argc) {
+                opts.threads = std::stoi(argv[++i]);
+                if (opts.threads <= 0) {
+                    std::cout << "Erro: --threads deve ser maior que 0" << std::endl;
+                    exit(1);
+                }
+            } else {
+                std::cout << "Erro: --threads requer um número" << std::endl;
+                PrintUsage(argv[0]);
+                exit(1);
+            }
+        }
+        else if (strcmp(argv[i], "--grasp-threads") == 0) {
+            if (i + 1 < argc) {
+                opts.grasp_threads = std::stoi(argv[++i]);
+                if (opts.grasp_threads <= 0) {
+                    std::cout << "Erro: --grasp-threads deve ser maior que 0" << std::endl;
+                    exit(1);
+                }
+            } else {
+                std::cout << "Erro: --grasp-threads requer um número" << std::endl;
+                PrintUsage(argv[0]);
+                exit(1);
+            }
+        }
+        else if (strcmp(argv[i], "--batch") == 0) {
+            if (i + 1 < argc) {
+                opts.batch = std::stoi(argv[++i]);
+                if (opts.batch <= 0) {
+                    std::cout << "Erro: --batch deve ser maior que 0" << std::endl;
+                    exit(1);
+                }
+            } else {
+                std::cout << "Erro: --batch requer um número" << std::endl;
+                PrintUsage(argv[0]);
+                exit(1);
+            }
+        }
+        else if (strcmp(argv[i], "--elite") == 0) {
+            if (i + 1 < argc) {
+                opts.elite_size = std::stoi(argv[++i]);
+                if (opts.elite_size < 0) {
+                    std::cout << "Erro: --elite não pode ser negativo" << std::endl;
+                    exit(1);
+                }
+            } else {
+                std::cout << "Erro: --elite requer um número" << std::endl;
+                PrintUsage(argv[0]);
+                exit(1);
+            }
+        }
+        else if (strcmp(argv[i], "--relink-every") == 0) {
+            if (i + 1 < argc) {
+                opts.relink_every = std::stoi(argv[++i]);
+                if (opts.relink_every <= 0) {
+                    std::cout << "Erro: --relink-every deve ser maior que 0" << std::endl;
+                    exit(1);
+                }
+            } else {
+                std::cout << "Erro: --relink-every requer um número" << std::endl;
+                PrintUsage(argv[0]);
+                exit(1);
+            }
+        }
+        else if (strcmp(argv[i], "--relink-pairs") == 0) {
+            if (i + 1 < argc) {
+                opts.relink_pairs = std::stoi(argv[++i]);
+                if (opts.relink_pairs <= 0) {
+                    std::cout << "Erro: --relink-pairs deve ser maior que 0" << std::endl;
+                    exit(1);
+                }
+            } else {
+                std::cout << "Erro: --relink-pairs requer um número" << std::endl;
+                PrintUsage(argv[0]);
+                exit(1);
+            }
+        }
+        else if (strcmp(argv[i], "--resequence") == 0) {
+            opts.resequence = true;
+        }
+        else if (strcmp(argv[i], "--oropt") == 0) {
+            if (i + 1 < argc) {
+                opts.or_opt_max = std::stoi(argv[++i]);
+                if (opts.or_opt_max <= 0) {
+                    std::cout << "Erro: --oropt deve ser maior que 0" << std::endl;
+                    exit(1);
+                }
+            } else {
+                std::cout << "Erro: --oropt requer um tamanho máximo de trecho" << std::endl;
+                PrintUsage(argv[0]);
+                exit(1);
+            }
+        }
+        else if (strcmp(argv[i], "--decompose") == 0) {
+            opts.decompose = true;
+            opts.use_ils = true;
+        }
+        else if (strcmp(argv[i], "--decompose-size") == 0) {
+            if (i + 1 < argc) {
+                opts.decompose_size = std::stoi(argv[++i]);
+                if (opts.decompose_size <= 0) {
+                    std::cout << "Erro: --decompose-size deve ser maior que 0" << std::endl;
+                    exit(1);
+                }
+            } else {
+                std::cout << "Erro: --decompose-size requer um número" << std::endl;
+                PrintUsage(argv[0]);
+                exit(1);
+            }
+        }
+        else if (strcmp(argv[i], "--aggregate") == 0) {
+            if (i + 1 < argc) {
+                opts.aggregate = true;
+                opts.aggregate_threshold = std::stod(argv[++i]);
+                if (opts.aggregate_threshold < 0.0) {
+                    std::cout << "Erro: --aggregate deve ser maior ou igual a 0" << std::endl;
+                    exit(1);
+                }
+            } else {
+                std::cout << "Erro: --aggregate requer um limiar de custo" << std::endl;
+                PrintUsage(argv[0]);
+                exit(1);
+            }
+        }
+        else if (strcmp(argv[i], "--penalized") == 0) {
+            opts.penalized = true;
+        }
+        else if (strcmp(argv[i], "--penalty-target") == 0) {
+            if (i + 1 < argc) {
+                opts.penalty_target = std::stod(argv[++i]);
+                if (opts.penalty_target <= 0.0 || opts.penalty_target >= 1.0) {
+                    std::cout << "Erro: --penalty-target deve estar entre 0.0 e 1.0 (exclusivo)" << std::endl;
+                    exit(1);
+                }
+            } else {
+                std::cout << "Erro: --penalty-target requer um número" << std::endl;
+                PrintUsage(argv[0]);
+                exit(1);
+            }
+        }
+        else if (strcmp(argv[i], "--daemon") == 0) {
+            opts.daemon = true;
+        }
+        else if (strcmp(argv[i], "--socket") == 0) {
+            if (i + 1 < argc) {
+                opts.socket_path = argv[++i];
+                opts.daemon = true;
+            } else {
+                std::cout << "Erro: --socket requer um caminho" << std::endl;
+                PrintUsage(argv[0]);
+                exit(1);
+            }
+        }
+        else if (strcmp(argv[i], "--cache-size") == 0) {
+            if (i + 1 < argc) {
+                opts.cache_size = std::stoi(argv[++i]);
+                if (opts.cache_size <= 0) {
+                    std::cout << "Erro: --cache-size deve ser maior que 0" << std::endl;
+                    exit(1);
+                }
+            } else {
+                std::cout << "Erro: --cache-size requer um número" << std::endl;
+                PrintUsage(argv[0]);
+                exit(1);
+            }
+        }
         else if (strcmp(argv[i], "--help") == 0) {
             PrintUsage(argv[0]);
             exit(0);
         }
     }
 
-    if (opts.instance_path.empty()) {
+    if (opts.instance_path.empty() && !opts.daemon) {
         std::cout << "Erro: Instância é obrigatória (--instance PATH)" << std::endl;
         PrintUsage(argv[0]);
         exit(1);
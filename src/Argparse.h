@@ -6,11 +6,13 @@
 struct CLIOptions {
     std::string instance_path = "";
     unsigned int seed = 42;
-    std::string constructive_method = "nearest";  // "nearest" ou "insertion"
+    std::string constructive_method = "nearest";  // "nearest", "insertion" ou "savings"
     bool use_vnd = true;
     std::string output_dir = "outputs/";
     bool run_feastest = false;
     bool verbose = false;
+    bool renumber = false;  // renumera estações por localidade antes de resolver
+    bool shared_memory = false;  // matriz num segmento POSIX compartilhado entre processos
     
     // ILS metaheuristic options
     bool use_ils = false;
@@ -19,6 +21,35 @@ struct CLIOptions {
     double rcl_alpha_min = 0.1;
     double rcl_alpha_max = 0.5;
     int perturb_strength = 2;
+    double time_limit = 0.0;  // segundos; 0 = sem limite
+    int threads = 0;          // 0 = fluxo aleatório único; >= 1 = modo determinístico
+    int batch = 8;            // reinícios por rodada no modo determinístico
+    int grasp_threads = 1;    // threads na avaliação de candidatos do GRASP
+    int elite_size = 0;       // conjunto elite + path relinking (0 = desligado)
+    int relink_every = 5;
+    int relink_pairs = 3;
+    bool penalized = false;        // busca penalizada com λ adaptativo
+    double penalty_target = 0.5;   // fração alvo de ótimos locais viáveis
+    bool resequence = false;       // re-sequenciamento exato das rotas curtas no RVND
+    int or_opt_max = 0;            // Or-opt-1..K com inversão no lugar do Or-opt-2 (0 = desligado)
+    bool decompose = false;        // ILS em subproblemas de rotas próximas (POPMUSIC)
+    int decompose_size = 100;      // estações por subproblema
+    bool aggregate = false;        // agrega estações quase coincidentes antes de resolver
+    double aggregate_threshold = 0.0;  // custo máximo (nos dois sentidos) entre estações agregadas
+
+    // Warm start a partir de um .out anterior (demandas atuais vêm de --instance)
+    std::string warm_start_path = "";
+
+    // Registro de convergência (JSON lines) e tempos por fase
+    std::string trace_path = "";
+
+    // Fração dos movimentos aceitos conferida contra a avaliação de referência (0 = desligado)
+    double verify = 0.0;
+
+    // Modo daemon (instâncias em cache, pedidos por protocolo de linhas)
+    bool daemon = false;
+    std::string socket_path = "";  // vazio => stdin/stdout
+    int cache_size = 8;
 };
 
 CLIOptions ParseCLI(int argc, char* argv[]);
@@ -1,7 +1,8 @@
 #include "Construction.h"
+#include "Parallel.h"
 #include <algorithm>
 #include <limits>
-#include <iostream>
+#include <queue>
 
 double RouteCost(const Data& data, const Route& route) {
     double cost = 0.0;
@@ -28,42 +29,76 @@ double SolutionCost(const Data& data, const Solution& solution) {
     return total_cost;
 }
 
+int UnroutedStations(const Data& data, const Solution& solution) {
+    std::vector<char> routed(data.getNumStations() + 1, 0);
+    for (const Route& route : solution.routes) {
+        for (int v : route.nodes) {
+            routed[v] = 1;
+        }
+    }
+    return static_cast<int>(std::count(routed.begin() + 1, routed.end(), 0));
+}
+
 Solution GreedyNearestFeasible(const Data& data, std::mt19937& rng) {
     Solution solution;
     const int n_stations = data.getNumStations();
     const int max_vehicles = data.getNumVehicles();
+    const long long Q = static_cast<long long>(data.getVehicleCapacity());
 
     std::vector<bool> unvisited(n_stations + 1, true);
     unvisited[0] = false;
     int remaining_stations = n_stations;
+
+    // Estações pendentes em vetor compacto (remoção O(1) por troca com o último)
+    std::vector<int> pending(n_stations);
+    std::vector<int> pending_pos(n_stations + 1, -1);
+    for (int station = 1; station <= n_stations; ++station) {
+        pending[station - 1] = station;
+        pending_pos[station] = station - 1;
+    }
+
     while (remaining_stations > 0 && static_cast<int>(solution.routes.size()) < max_vehicles) {
         Route current_route;
         current_route.nodes.push_back(0);
 
+        // Acrescentar uma estação só altera o último prefixo: a janela de L0 da rota
+        // estendida sai dos prefixos corrente/máximo/mínimo em O(1)
+        long long prefix = 0;
+        long long max_prefix = 0;
+        long long min_prefix = 0;
+        auto fits = [&](int station) {
+            long long next = prefix + NodeDemand(data, station);
+            long long L0_min = std::max(0LL, -std::min(min_prefix, next));
+            long long L0_max = Q - std::max(max_prefix, next);
+            return L0_min <= L0_max;
+        };
+
         int current_station = 0;
         while (true) {
             int best_station = -1;
-            double best_cost = std::numeric_limits<double>::infinity();
-
-            for (int station = 1; station <= n_stations; ++station) {
-                if (!unvisited[station]) {
-                    continue;
-                }
 
-                Route test_route = current_route;
-                test_route.nodes.push_back(station);
-                test_route.nodes.push_back(0);
-
-                RouteFeasInfo feas_info = CheckRouteFeasible(data, test_route);
-                if (!feas_info.ok) {
-                    continue;
+            // A lista de vizinhos está ordenada por (custo, id): o primeiro candidato
+            // não visitado e viável é exatamente o escolhido pela varredura completa
+            for (int station : data.getNeighbors(current_station)) {
+                if (unvisited[station] && fits(station)) {
+                    best_station = station;
+                    break;
                 }
+            }
 
-                double travel_cost = data.getTravelCost(current_station, station);
+            // Lista esgotada: varre apenas as estações pendentes
+            if (best_station == -1) {
+                double best_cost = std::numeric_limits<double>::infinity();
+                for (int station : pending) {
+                    if (!fits(station)) {
+                        continue;
+                    }
 
-                if (travel_cost < best_cost) {
-                    best_cost = travel_cost;
-                    best_station = station;
+                    double travel_cost = data.getTravelCost(current_station, station);
+                    if (travel_cost < best_cost || (travel_cost == best_cost && station < best_station)) {
+                        best_cost = travel_cost;
+                        best_station = station;
+                    }
                 }
             }
 
@@ -74,6 +109,15 @@ Solution GreedyNearestFeasible(const Data& data, std::mt19937& rng) {
             unvisited[best_station] = false;
             remaining_stations--;
             current_station = best_station;
+
+            prefix += NodeDemand(data, best_station);
+            max_prefix = std::max(max_prefix, prefix);
+            min_prefix = std::min(min_prefix, prefix);
+
+            int slot = pending_pos[best_station];
+            pending[slot] = pending.back();
+            pending_pos[pending[slot]] = slot;
+            pending.pop_back();
         }
 
         current_route.nodes.push_back(0);
@@ -83,8 +127,6 @@ Solution GreedyNearestFeasible(const Data& data, std::mt19937& rng) {
         }
 
         if (current_route.nodes.size() <= 2) {
-            std::cout << "Aviso: Não foi possível atribuir todas as estações aos veículos disponíveis." << std::endl;
-            std::cout << "Estações restantes: " << remaining_stations << std::endl;
             break;
         }
     }
@@ -106,6 +148,15 @@ Solution GreedyBestInsertion(const Data& data, std::mt19937& rng) {
     Route initial_route;
     initial_route.nodes = {0, 0};
     solution.routes.push_back(initial_route);
+
+    // Janela de carga por rota (mantida a cada inserção): descarta pares (estação, rota)
+    // inviáveis só pela demanda antes de varrer posições
+    const long long Q = static_cast<long long>(data.getVehicleCapacity());
+    std::vector<RouteLoadWindow> windows(1);
+    std::vector<long long> demand(n_stations + 1, 0);
+    for (int station = 1; station <= n_stations; ++station) {
+        demand[station] = NodeDemand(data, station);
+    }
     while (remaining_stations > 0) {
         int best_station = -1;
         size_t best_route_idx = 0;
@@ -119,6 +170,9 @@ Solution GreedyBestInsertion(const Data& data, std::mt19937& rng) {
             }
 
             for (size_t route_idx = 0; route_idx < solution.routes.size(); ++route_idx) {
+                if (!MayShiftSuffix(windows[route_idx], demand[station], Q)) {
+                    continue;
+                }
                 const Route& current_route = solution.routes[route_idx];
 
                 // (exceto primeira e última que são sempre depósito)
@@ -153,13 +207,12 @@ Solution GreedyBestInsertion(const Data& data, std::mt19937& rng) {
                 solution.routes[best_route_idx].nodes.begin() + best_position,
                 best_station
             );
+            windows[best_route_idx] = LoadWindowOf(data, solution.routes[best_route_idx]);
             unvisited[best_station] = false;
             remaining_stations--;
         }
         else {
             if (static_cast<int>(solution.routes.size()) >= max_vehicles) {
-                std::cout << "Aviso: Não há veículos suficientes para atender todas as estações." << std::endl;
-                std::cout << "Estações restantes: " << remaining_stations << std::endl;
                 break;
             }
 
@@ -188,10 +241,10 @@ Solution GreedyBestInsertion(const Data& data, std::mt19937& rng) {
                 Route new_route;
                 new_route.nodes = {0, nearest_station, 0};
                 solution.routes.push_back(new_route);
+                windows.push_back(LoadWindowOf(data, new_route));
                 unvisited[nearest_station] = false;
                 remaining_stations--;
             } else {
-                std::cout << "Erro: Não foi possível criar rota viável para estações restantes." << std::endl;
                 break;
             }
         }
@@ -202,7 +255,7 @@ Solution GreedyBestInsertion(const Data& data, std::mt19937& rng) {
     return solution;
 }
 
-Solution BuildInitial_GRASP(const Data& data, std::mt19937& rng, double alpha_in) {
+Solution BuildInitial_GRASP(const Data& data, std::mt19937& rng, double alpha_in, int threads) {
     Solution solution;
     const int n_stations = data.getNumStations();
     const int max_vehicles = data.getNumVehicles();
@@ -211,10 +264,25 @@ Solution BuildInitial_GRASP(const Data& data, std::mt19937& rng, double alpha_in
     unvisited[0] = false;
     int remaining_stations = n_stations;
 
+    // Estações ainda não visitadas, em ordem crescente (a ordem dos candidatos)
+    std::vector<int> pending;
+    for (int station = 1; station <= n_stations; ++station) {
+        pending.push_back(station);
+    }
+
     Route initial_route;
     initial_route.nodes = {0, 0};
     solution.routes.push_back(initial_route);
 
+    // Janela de carga por rota (mantida a cada inserção): descarta pares (estação, rota)
+    // inviáveis só pela demanda antes de varrer posições
+    const long long Q = static_cast<long long>(data.getVehicleCapacity());
+    std::vector<RouteLoadWindow> windows(1);
+    std::vector<long long> demand(n_stations + 1, 0);
+    for (int station = 1; station <= n_stations; ++station) {
+        demand[station] = NodeDemand(data, station);
+    }
+
     struct InsertionCandidate {
         int station;
         size_t route_idx;
@@ -222,19 +290,21 @@ Solution BuildInitial_GRASP(const Data& data, std::mt19937& rng, double alpha_in
         double delta_cost;
     };
 
-    while (remaining_stations > 0) {
-        std::vector<InsertionCandidate> candidates;
-
-        for (int station = 1; station <= n_stations; ++station) {
-            if (!unvisited[station]) {
-                continue;
-            }
+    // Candidatos das estações pending[begin, end), na ordem (estação, rota, posição)
+    auto evaluate = [&](size_t begin, size_t end, std::vector<InsertionCandidate>& out) {
+        Route test_route;
+        for (size_t k = begin; k < end; ++k) {
+            int station = pending[k];
 
             for (size_t route_idx = 0; route_idx < solution.routes.size(); ++route_idx) {
+                if (!MayShiftSuffix(windows[route_idx], demand[station], Q)) {
+                    continue;
+                }
                 const Route& current_route = solution.routes[route_idx];
+                double original_cost = RouteCost(data, current_route);
 
                 for (size_t pos = 1; pos < current_route.nodes.size(); ++pos) {
-                    Route test_route = current_route;
+                    test_route.nodes.assign(current_route.nodes.begin(), current_route.nodes.end());
                     test_route.nodes.insert(test_route.nodes.begin() + pos, station);
 
                     RouteFeasInfo feas_info = CheckRouteFeasible(data, test_route);
@@ -242,14 +312,40 @@ Solution BuildInitial_GRASP(const Data& data, std::mt19937& rng, double alpha_in
                         continue;
                     }
 
-                    double original_cost = RouteCost(data, current_route);
                     double new_cost = RouteCost(data, test_route);
                     double delta_cost = new_cost - original_cost;
 
-                    candidates.push_back({station, route_idx, pos, delta_cost});
+                    out.push_back({station, route_idx, pos, delta_cost});
                 }
             }
         }
+    };
+
+    // Avaliação paralela: blocos de estações com buffer próprio, concatenados na ordem dos
+    // blocos. A lista fica idêntica à sequencial, então ordenação, RCL e sorteio também.
+    // As threads são criadas uma vez por construção e recebem um lote de blocos por passo
+    WorkerPool pool(threads > 1 ? threads : 1);
+    std::vector<InsertionCandidate> candidates;
+    std::vector<std::vector<InsertionCandidate>> chunk_candidates;
+
+    while (remaining_stations > 0) {
+        candidates.clear();
+        if (threads > 1 && pending.size() > kGraspChunkStations) {
+            int chunks = static_cast<int>((pending.size() + kGraspChunkStations - 1) / kGraspChunkStations);
+            if (static_cast<int>(chunk_candidates.size()) < chunks) {
+                chunk_candidates.resize(chunks);
+            }
+            pool.run(chunks, [&](int c) {
+                size_t begin = static_cast<size_t>(c) * kGraspChunkStations;
+                chunk_candidates[c].clear();
+                evaluate(begin, std::min(pending.size(), begin + kGraspChunkStations), chunk_candidates[c]);
+            });
+            for (int c = 0; c < chunks; ++c) {
+                candidates.insert(candidates.end(), chunk_candidates[c].begin(), chunk_candidates[c].end());
+            }
+        } else {
+            evaluate(0, pending.size(), candidates);
+        }
 
         if (!candidates.empty()) {
             std::sort(candidates.begin(), candidates.end(),
@@ -275,13 +371,13 @@ Solution BuildInitial_GRASP(const Data& data, std::mt19937& rng, double alpha_in
                 solution.routes[selected.route_idx].nodes.begin() + selected.position,
                 selected.station
             );
+            windows[selected.route_idx] = LoadWindowOf(data, solution.routes[selected.route_idx]);
             unvisited[selected.station] = false;
+            pending.erase(std::lower_bound(pending.begin(), pending.end(), selected.station));
             remaining_stations--;
         }
         else {
             if (static_cast<int>(solution.routes.size()) >= max_vehicles) {
-                std::cout << "Aviso: Não há veículos suficientes para atender todas as estações." << std::endl;
-                std::cout << "Estações restantes: " << remaining_stations << std::endl;
                 break;
             }
 
@@ -310,10 +406,11 @@ Solution BuildInitial_GRASP(const Data& data, std::mt19937& rng, double alpha_in
                 Route new_route;
                 new_route.nodes = {0, nearest_station, 0};
                 solution.routes.push_back(new_route);
+                windows.push_back(LoadWindowOf(data, new_route));
                 unvisited[nearest_station] = false;
+                pending.erase(std::lower_bound(pending.begin(), pending.end(), nearest_station));
                 remaining_stations--;
             } else {
-                std::cout << "Erro: Não foi possível criar rota viável para estações restantes." << std::endl;
                 break;
             }
         }
@@ -322,4 +419,183 @@ Solution BuildInitial_GRASP(const Data& data, std::mt19937& rng, double alpha_in
     solution.total_cost = SolutionCost(data, solution);
 
     return solution;
-}
\ No newline at end of file
+}
+namespace {
+
+struct SavingsRoute {
+    int head;
+    int tail;
+    RouteLoadWindow window;
+    bool alive = true;
+};
+
+} // namespace
+
+Solution ClarkeWrightSavings(const Data& data, std::mt19937& rng) {
+    Solution solution;
+    const int n_stations = data.getNumStations();
+    const int max_vehicles = data.getNumVehicles();
+    const long long Q = static_cast<long long>(data.getVehicleCapacity());
+
+    // Uma rota 0 -> i -> 0 por estação; next_station encadeia as estações de cada rota
+    std::vector<SavingsRoute> routes(n_stations + 1);
+    std::vector<int> route_of(n_stations + 1);
+    std::vector<int> next_station(n_stations + 1, 0);
+    for (int i = 1; i <= n_stations; ++i) {
+        long long d = NodeDemand(data, i);
+        routes[i] = {i, i, {d, std::max(0LL, d), std::min(0LL, d)}};
+        route_of[i] = i;
+    }
+
+    // Fusão A + B pela ligação tail(A) -> head(B) (sentido importa com custos assimétricos);
+    // a janela de carga da concatenação sai das duas janelas em O(1)
+    auto try_merge = [&](int i, int j) {
+        int a = route_of[i];
+        int b = route_of[j];
+        // route_of só é confiável nas pontas de rotas vivas
+        if (a == b || !routes[a].alive || !routes[b].alive || routes[a].tail != i || routes[b].head != j) {
+            return false;
+        }
+        RouteLoadWindow merged = ConcatWindows(routes[a].window, routes[b].window);
+        if (!WindowFits(merged, Q)) {
+            return false;
+        }
+        next_station[i] = j;
+        routes[a].tail = routes[b].tail;
+        routes[a].window = merged;
+        routes[b].alive = false;
+        // Só as pontas precisam saber a rota: head(A) não mudou, a nova cauda passa a A
+        route_of[routes[a].tail] = a;
+        return true;
+    };
+
+    struct Saving {
+        double value;
+        int from;
+        int to;
+        bool operator<(const Saving& other) const {
+            if (value != other.value) return value < other.value;
+            if (from != other.from) return from > other.from;
+            return to > other.to;
+        }
+    };
+
+    // Economias apenas entre vizinhos próximos: s(i,j) = c(i,0) + c(0,j) - c(i,j)
+    std::vector<Saving> savings;
+    savings.reserve(static_cast<size_t>(n_stations) * std::min(n_stations, Data::kNeighborListSize));
+    for (int i = 1; i <= n_stations; ++i) {
+        for (int j : data.getNeighbors(i)) {
+            double value = data.getTravelCost(i, 0) + data.getTravelCost(0, j) - data.getTravelCost(i, j);
+            if (value > 0.0) {
+                savings.push_back({value, i, j});
+            }
+        }
+    }
+
+    std::priority_queue<Saving> heap(std::less<Saving>(), std::move(savings));
+    int route_count = n_stations;
+    while (!heap.empty()) {
+        Saving s = heap.top();
+        heap.pop();
+        if (try_merge(s.from, s.to)) {
+            route_count--;
+        }
+    }
+
+    // Pontas que não são vizinhas próximas nunca entram na fila: funde rotas inteiras pela
+    // melhor economia viável entre as pontas restantes. Com até kEndpointPassMaxRoutes rotas a
+    // passada olha todos os pares; acima disso só pares cauda -> cabeça com a cabeça na lista de
+    // vizinhos da cauda (O(R·K)), e só quando essa passada não funde nada uma passada larga olha
+    // todas as cabeças guardando as K melhores por cauda (memória O(R·K) em vez de O(R^2)). Com
+    // mais rotas que veículos aceita também economias negativas, até caber na frota ou não haver
+    // fusão possível.
+    constexpr int kEndpointPassMaxRoutes = 2000;
+    bool wide = false;
+    while (route_count > max_vehicles || route_count <= kEndpointPassMaxRoutes) {
+        bool over_fleet = route_count > max_vehicles;
+        bool all_pairs = route_count <= kEndpointPassMaxRoutes;
+        std::vector<int> alive;
+        for (int r = 1; r <= n_stations; ++r) {
+            if (routes[r].alive) {
+                alive.push_back(r);
+            }
+        }
+
+        auto consider = [&](int a, int b, std::vector<Saving>& out) {
+            if (a == b || !WindowFits(ConcatWindows(routes[a].window, routes[b].window), Q)) {
+                return;
+            }
+            int i = routes[a].tail;
+            int j = routes[b].head;
+            double value = data.getTravelCost(i, 0) + data.getTravelCost(0, j) - data.getTravelCost(i, j);
+            if (value > 0.0 || over_fleet) {
+                out.push_back({value, i, j});
+            }
+        };
+        auto by_value = [](const Saving& x, const Saving& y) { return y < x; };
+
+        std::vector<Saving> candidates;
+        if (all_pairs) {
+            for (int a : alive) {
+                for (int b : alive) {
+                    consider(a, b, candidates);
+                }
+            }
+        } else if (!wide) {
+            for (int a : alive) {
+                for (int j : data.getNeighbors(routes[a].tail)) {
+                    // route_of[j] só aponta a rota certa quando j é ponta; a cabeça confere
+                    int b = route_of[j];
+                    if (routes[b].alive && routes[b].head == j) {
+                        consider(a, b, candidates);
+                    }
+                }
+            }
+        } else {
+            std::vector<Saving> per_tail;
+            for (int a : alive) {
+                per_tail.clear();
+                for (int b : alive) {
+                    consider(a, b, per_tail);
+                }
+                size_t keep = std::min(per_tail.size(), static_cast<size_t>(Data::kNeighborListSize));
+                std::partial_sort(per_tail.begin(), per_tail.begin() + keep, per_tail.end(), by_value);
+                candidates.insert(candidates.end(), per_tail.begin(), per_tail.begin() + keep);
+            }
+        }
+
+        std::sort(candidates.begin(), candidates.end(), by_value);
+        int merged = 0;
+        for (const Saving& s : candidates) {
+            if (s.value <= 0.0 && route_count <= max_vehicles) {
+                break;
+            }
+            if (try_merge(s.from, s.to)) {
+                route_count--;
+                merged++;
+            }
+        }
+        // Passada de vizinhos sem fusão ainda tenta a larga antes de desistir
+        if (merged == 0 && (all_pairs || wide)) {
+            break;
+        }
+        wide = merged == 0;
+    }
+
+    for (int r = 1; r <= n_stations; ++r) {
+        if (!routes[r].alive) {
+            continue;
+        }
+        Route route;
+        route.nodes.push_back(0);
+        for (int v = routes[r].head; v != 0; v = next_station[v]) {
+            route.nodes.push_back(v);
+        }
+        route.nodes.push_back(0);
+        solution.routes.push_back(std::move(route));
+    }
+
+    solution.total_cost = SolutionCost(data, solution);
+
+    return solution;
+}
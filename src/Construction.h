@@ -13,12 +13,23 @@ struct Solution {
 
 [[nodiscard]] double RouteCost(const Data& data, const Route& route);
 [[nodiscard]] double SolutionCost(const Data& data, const Solution& solution);
+// Estações fora de todas as rotas. Sem veículos suficientes os construtivos não imprimem nada:
+// devolvem a solução parcial, e quem chama decide como relatar (Solve, SolveResult::warning).
+[[nodiscard]] int UnroutedStations(const Data& data, const Solution& solution);
 
 Solution GreedyNearestFeasible(const Data& data, std::mt19937& rng);
 Solution GreedyBestInsertion(const Data& data, std::mt19937& rng);
+// Clarke–Wright (economias) com fila de prioridade restrita aos vizinhos mais próximos
+Solution ClarkeWrightSavings(const Data& data, std::mt19937& rng);
 
+// Estações por bloco na avaliação paralela de candidatos do GRASP
+constexpr size_t kGraspChunkStations = 32;
+
+// Inserção mais barata randomizada (RCL com limiar α). Com threads > 1 os candidatos de cada
+// passo são avaliados em paralelo; a solução é a mesma para qualquer número de threads.
 [[nodiscard]] Solution BuildInitial_GRASP(const Data& data,
                                           std::mt19937& rng,
-                                          double alpha_in);
+                                          double alpha_in,
+                                          int threads = 1);
 
 #endif
\ No newline at end of file
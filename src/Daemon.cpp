@@ -0,0 +1,514 @@
+#include "Daemon.h"
+#include "Construction.h"
+#include "Feasibility.h"
+#include "ILS.h"
+#include "Instance.h"
+#include "Solver.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double ElapsedMs(Clock::time_point since) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - since).count();
+}
+
+std::string HexId(uint64_t id) {
+    char buf[17];
+    std::snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(id));
+    return buf;
+}
+
+// FNV-1a 64 sobre o conteúdo do arquivo
+bool HashFileContents(const std::string& path, uint64_t& hash) {
+    std::ifstream in(path, std::ios::in | std::ios::binary);
+    if (!in) {
+        return false;
+    }
+
+    hash = 0xcbf29ce484222325ULL;
+    std::vector<char> buffer(1 << 16);
+    while (in) {
+        in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        std::streamsize got = in.gcount();
+        for (std::streamsize i = 0; i < got; ++i) {
+            hash ^= static_cast<unsigned char>(buffer[i]);
+            hash *= 0x100000001b3ULL;
+        }
+    }
+    return true;
+}
+
+// Cache LRU de instâncias por hash de conteúdo. Um memo (caminho, tamanho, mtime) -> hash
+// evita reler o arquivo quando ele não mudou desde o último pedido.
+class InstanceCache {
+public:
+    explicit InstanceCache(int capacity) : capacity(std::max(1, capacity)) {}
+
+    std::shared_ptr<const Data> acquire(const std::string& path, uint64_t& id, bool& hit, std::string& error) {
+        std::error_code ec;
+        auto size = std::filesystem::file_size(path, ec);
+        auto mtime = std::filesystem::last_write_time(path, ec);
+        if (ec) {
+            error = "arquivo não encontrado: " + path;
+            return nullptr;
+        }
+
+        // Hash e leitura acontecem fora do mutex: uma instância grande (ou um arquivo lento) não
+        // bloqueia os pedidos de outras conexões, que só disputam o mutex nas consultas ao mapa
+        bool memo_valid = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto memo = path_memo.find(path);
+            if (memo != path_memo.end() && memo->second.size == size && memo->second.mtime == mtime) {
+                id = memo->second.hash;
+                memo_valid = true;
+            }
+        }
+        if (!memo_valid && !HashFileContents(path, id)) {
+            error = "não foi possível ler: " + path;
+            return nullptr;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!memo_valid) {
+                path_memo[path] = {size, mtime, id};
+            }
+            if (auto data = lookup(id)) {
+                hit = true;
+                hits++;
+                return data;
+            }
+            misses++;
+        }
+
+        hit = false;
+        auto data = std::make_shared<Data>(path);
+        if (!data->tryRead(error)) {
+            return nullptr;
+        }
+        (void)data->getNeighbors(0); // pré-computa as listas de vizinhos junto com a leitura
+
+        std::lock_guard<std::mutex> lock(mutex);
+        // Outra conexão pode ter lido a mesma instância enquanto esta lia: fica a que já está no cache
+        if (auto cached = lookup(id)) {
+            return cached;
+        }
+        lru.push_front(id);
+        entries[id] = {data, lru.begin()};
+        while (static_cast<int>(entries.size()) > capacity) {
+            entries.erase(lru.back());
+            lru.pop_back();
+        }
+        return data;
+    }
+
+    std::shared_ptr<const Data> find(uint64_t id) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto data = lookup(id);
+        data ? hits++ : misses++;
+        return data;
+    }
+
+    bool evict(uint64_t id) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = entries.find(id);
+        if (it == entries.end()) {
+            return false;
+        }
+        lru.erase(it->second.lru_pos);
+        entries.erase(it);
+        return true;
+    }
+
+    std::string stats() {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::ostringstream out;
+        out << "instances=" << entries.size() << " capacity=" << capacity << " hits=" << hits << " misses=" << misses;
+        return out.str();
+    }
+
+private:
+    struct Entry {
+        std::shared_ptr<const Data> data;
+        std::list<uint64_t>::iterator lru_pos;
+    };
+    struct PathMemo {
+        uintmax_t size;
+        std::filesystem::file_time_type mtime;
+        uint64_t hash;
+    };
+
+    // Chamador detém o mutex
+    std::shared_ptr<const Data> lookup(uint64_t id) {
+        auto it = entries.find(id);
+        if (it == entries.end()) {
+            return nullptr;
+        }
+        lru.splice(lru.begin(), lru, it->second.lru_pos);
+        return it->second.data;
+    }
+
+    int capacity;
+    std::mutex mutex;
+    std::list<uint64_t> lru;
+    std::unordered_map<uint64_t, Entry> entries;
+    std::unordered_map<std::string, PathMemo> path_memo;
+    long long hits = 0;
+    long long misses = 0;
+};
+
+// Canal de linhas sobre descritores (stdin/stdout ou um socket conectado)
+class LineChannel {
+public:
+    LineChannel(int in_fd, int out_fd) : in_fd(in_fd), out_fd(out_fd) {}
+
+    bool readLine(std::string& line) {
+        while (true) {
+            auto newline = buffer.find('\n');
+            if (newline != std::string::npos) {
+                line = buffer.substr(0, newline);
+                buffer.erase(0, newline + 1);
+                if (!line.empty() && line.back() == '\r') {
+                    line.pop_back();
+                }
+                return true;
+            }
+            char chunk[4096];
+            ssize_t got = ::read(in_fd, chunk, sizeof(chunk));
+            if (got <= 0) {
+                if (!buffer.empty()) {
+                    line.swap(buffer);
+                    buffer.clear();
+                    return true;
+                }
+                return false;
+            }
+            buffer.append(chunk, static_cast<size_t>(got));
+        }
+    }
+
+    bool write(const std::string& text) {
+        size_t sent = 0;
+        while (sent < text.size()) {
+            ssize_t wrote = ::write(out_fd, text.data() + sent, text.size() - sent);
+            if (wrote <= 0) {
+                return false;
+            }
+            sent += static_cast<size_t>(wrote);
+        }
+        return true;
+    }
+
+private:
+    int in_fd;
+    int out_fd;
+    std::string buffer;
+};
+
+struct SolveOptions {
+    unsigned int seed = 42;
+    std::string method = "nearest"; // "nearest", "insertion", "savings" ou "ils"
+    bool use_vnd = true;
+    bool progress = false;
+    ILSParams ils;
+};
+
+bool ParseSolveOptions(const std::map<std::string, std::string>& args, SolveOptions& o, std::string& error) {
+    try {
+        for (const auto& [key, value] : args) {
+            if (key == "instance" || key == "id") continue;
+            else if (key == "seed") o.seed = static_cast<unsigned int>(std::stoul(value));
+            else if (key == "method") o.method = value;
+            else if (key == "vnd") o.use_vnd = value != "0";
+            else if (key == "progress") o.progress = value != "0";
+            else if (key == "max-iter") o.ils.max_iter = std::stoi(value);
+            else if (key == "max-iter-ils") o.ils.max_iter_ils = std::stoi(value);
+            else if (key == "alpha-min") o.ils.alpha_min = std::stod(value);
+            else if (key == "alpha-max") o.ils.alpha_max = std::stod(value);
+            else if (key == "perturb-strength") o.ils.perturb_strength = std::stoi(value);
+            else if (key == "time-limit") o.ils.time_limit = std::stod(value);
+            else if (key == "threads") o.ils.threads = std::stoi(value);
+            else if (key == "batch") o.ils.batch = std::stoi(value);
+            else if (key == "grasp-threads") o.ils.grasp_threads = std::stoi(value);
+            else if (key == "elite") o.ils.elite_size = std::stoi(value);
+            else if (key == "relink-every") o.ils.relink_every = std::stoi(value);
+            else if (key == "relink-pairs") o.ils.relink_pairs = std::stoi(value);
+            else if (key == "penalized") o.ils.penalized = value != "0";
+            else if (key == "penalty-target") o.ils.penalty_target = std::stod(value);
+            else if (key == "resequence") o.ils.resequence = value != "0";
+            else if (key == "oropt") {
+                // Como --oropt: presente, exige K > 0 (ausente, fica o Or-opt-2)
+                o.ils.or_opt_max = std::stoi(value);
+                if (o.ils.or_opt_max <= 0) {
+                    error = "oropt deve ser maior que 0";
+                    return false;
+                }
+            }
+            else {
+                error = "parâmetro desconhecido: " + key;
+                return false;
+            }
+        }
+    } catch (const std::exception&) {
+        error = "valor inválido em solve";
+        return false;
+    }
+
+    if (o.method != "nearest" && o.method != "insertion" && o.method != "savings" && o.method != "ils") {
+        error = "method deve ser 'nearest', 'insertion', 'savings' ou 'ils'";
+        return false;
+    }
+    if (o.ils.max_iter <= 0 || o.ils.max_iter_ils <= 0 || o.ils.perturb_strength <= 0 ||
+        o.ils.threads < 0 || o.ils.batch <= 0 || o.ils.grasp_threads <= 0 || o.ils.elite_size < 0 || o.ils.relink_every <= 0 ||
+        o.ils.relink_pairs <= 0 || o.ils.penalty_target <= 0.0 || o.ils.penalty_target >= 1.0 ||
+        o.ils.alpha_min < 0.0 || o.ils.alpha_max > 1.0 || o.ils.alpha_min > o.ils.alpha_max) {
+        error = "parâmetros ILS fora do intervalo";
+        return false;
+    }
+    return true;
+}
+
+// Mesmo fluxo do executável (Solver.h): ILS, ou construtivo seguido de VND (descartado se inviável)
+Solution SolveRequest(const Data& data, const SolveOptions& o) {
+    SolverOptions options;
+    options.seed = o.seed;
+    options.use_ils = o.method == "ils";
+    options.constructive = options.use_ils ? "nearest" : o.method;
+    options.use_vnd = o.use_vnd;
+    options.ils = o.ils;
+    return Solve(data, options, false).solution;
+}
+
+std::string FormatSolution(const std::string& id, const Data& data, const Solution& solution, double solve_ms,
+                           bool cached) {
+    std::ostringstream out;
+    out << "solution id=" << id << " cost=" << solution.total_cost << " vehicles=" << solution.routes.size()
+        << " feasible=" << (CheckSolutionFeasible(data, solution.routes) ? 1 : 0) << " solve_ms=" << solve_ms
+        << " cached=" << (cached ? 1 : 0) << "\n";
+    for (const auto& route : solution.routes) {
+        out << "route";
+        for (int node : route.nodes) {
+            out << " " << node;
+        }
+        out << "\n";
+    }
+    out << "end\n";
+    return out.str();
+}
+
+// Atende uma conexão até EOF ou "quit"
+void Serve(LineChannel& channel, InstanceCache& cache) {
+    std::string line;
+    while (channel.readLine(line)) {
+        std::istringstream tokens(line);
+        std::string command;
+        if (!(tokens >> command)) {
+            continue;
+        }
+
+        std::map<std::string, std::string> args;
+        std::string token;
+        while (tokens >> token) {
+            auto eq = token.find('=');
+            if (eq == std::string::npos) {
+                args[token] = "1";
+            } else {
+                args[token.substr(0, eq)] = token.substr(eq + 1);
+            }
+        }
+
+        if (command == "quit") {
+            channel.write("ok bye\n");
+            return;
+        }
+        if (command == "ping") {
+            channel.write("ok pong\n");
+            continue;
+        }
+        if (command == "stats") {
+            channel.write("ok " + cache.stats() + "\n");
+            continue;
+        }
+        if (command == "evict") {
+            bool evicted = false;
+            try {
+                evicted = args.count("id") && cache.evict(std::stoull(args["id"], nullptr, 16));
+            } catch (const std::exception&) {
+                evicted = false;
+            }
+            channel.write(std::string("ok evicted=") + (evicted ? "1" : "0") + "\n");
+            continue;
+        }
+        if (command != "load" && command != "solve") {
+            channel.write("error comando desconhecido: " + command + "\n");
+            continue;
+        }
+
+        auto load_start = Clock::now();
+        std::shared_ptr<const Data> data;
+        uint64_t id = 0;
+        bool hit = false;
+        std::string error;
+
+        if (args.count("instance")) {
+            data = cache.acquire(args["instance"], id, hit, error);
+        } else if (args.count("id")) {
+            try {
+                id = std::stoull(args["id"], nullptr, 16);
+            } catch (const std::exception&) {
+                id = 0;
+            }
+            data = cache.find(id);
+            hit = data != nullptr;
+            if (!data) {
+                error = "instância não está em cache: " + args["id"];
+            }
+        } else {
+            error = "instance=PATH ou id=HASH obrigatório";
+        }
+
+        if (!data) {
+            channel.write("error " + error + "\n");
+            continue;
+        }
+
+        if (command == "load") {
+            std::ostringstream out;
+            out << "ok id=" << HexId(id) << " n=" << data->getNumStations() << " cached=" << (hit ? 1 : 0)
+                << " load_ms=" << ElapsedMs(load_start) << "\n";
+            channel.write(out.str());
+            continue;
+        }
+
+        SolveOptions options;
+        if (!ParseSolveOptions(args, options, error)) {
+            channel.write("error " + error + "\n");
+            continue;
+        }
+
+        auto solve_start = Clock::now();
+        if (options.progress) {
+            options.ils.on_improvement = [&channel, solve_start](const Solution& best) {
+                std::ostringstream out;
+                out << "progress cost=" << best.total_cost << " t_ms=" << ElapsedMs(solve_start) << "\n";
+                channel.write(out.str());
+            };
+        }
+
+        Solution solution = SolveRequest(*data, options);
+        channel.write(FormatSolution(HexId(id), *data, solution, ElapsedMs(solve_start), hit));
+    }
+}
+
+int ServeSocket(const DaemonOptions& options, InstanceCache& cache) {
+    int server = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (server < 0) {
+        std::cerr << "Erro: não foi possível criar socket" << std::endl;
+        return 1;
+    }
+
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (options.socket_path.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "Erro: caminho de socket muito longo: " << options.socket_path << std::endl;
+        close(server);
+        return 1;
+    }
+    std::strncpy(addr.sun_path, options.socket_path.c_str(), sizeof(addr.sun_path) - 1);
+    unlink(options.socket_path.c_str());
+
+    if (bind(server, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 || listen(server, 16) < 0) {
+        std::cerr << "Erro: não foi possível escutar em " << options.socket_path << std::endl;
+        close(server);
+        return 1;
+    }
+
+    std::cerr << "Daemon JP-Bike escutando em " << options.socket_path << std::endl;
+
+    // Uma thread por conexão; o cache é compartilhado e vive na pilha de RunDaemon, então as
+    // threads ficam joinable e são todas esperadas antes de retornar. As que já terminaram são
+    // recolhidas a cada nova conexão.
+    struct Connection {
+        std::thread thread;
+        std::shared_ptr<std::atomic<bool>> done;
+    };
+    std::vector<Connection> connections;
+    while (true) {
+        int client = accept(server, nullptr, nullptr);
+        if (client < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        connections.erase(std::remove_if(connections.begin(), connections.end(),
+                                         [](Connection& c) {
+                                             if (!c.done->load()) return false;
+                                             c.thread.join();
+                                             return true;
+                                         }),
+                          connections.end());
+        auto done = std::make_shared<std::atomic<bool>>(false);
+        connections.push_back({std::thread([client, &cache, done]() {
+                                   LineChannel channel(client, client);
+                                   Serve(channel, cache);
+                                   close(client);
+                                   done->store(true);
+                               }),
+                               done});
+    }
+    for (Connection& connection : connections) {
+        connection.thread.join();
+    }
+
+    close(server);
+    unlink(options.socket_path.c_str());
+    return 0;
+}
+
+} // namespace
+
+int RunDaemon(const DaemonOptions& options) {
+    std::signal(SIGPIPE, SIG_IGN);
+    InstanceCache cache(options.cache_size);
+
+    if (!options.socket_path.empty()) {
+        return ServeSocket(options, cache);
+    }
+
+    // Em stdin/stdout o protocolo fica num duplicado do stdout e o fd 1 passa a apontar
+    // para stderr, para que mensagens dos construtivos não corrompam as respostas
+    std::cout.flush();
+    int protocol_fd = dup(STDOUT_FILENO);
+    dup2(STDERR_FILENO, STDOUT_FILENO);
+
+    LineChannel channel(STDIN_FILENO, protocol_fd);
+    Serve(channel, cache);
+    close(protocol_fd);
+    return 0;
+}
@@ -0,0 +1,25 @@
+#ifndef DAEMON_H
+#define DAEMON_H
+
+#include <string>
+
+struct DaemonOptions {
+    std::string socket_path;   // vazio => protocolo de linhas em stdin/stdout
+    int         cache_size = 8; // instâncias mantidas em memória (LRU)
+};
+
+// Modo servidor: mantém instâncias lidas (e estruturas derivadas) em cache, indexadas pelo
+// hash do conteúdo do arquivo, e atende pedidos de solução por um protocolo de linhas.
+//
+//   load instance=PATH                      -> ok id=HASH n=N cached=0|1 load_ms=T
+//   solve (instance=PATH | id=HASH) [k=v]   -> [progress cost=C t_ms=T]* solution ... route ...* end
+//   evict id=HASH | stats | ping | quit
+//
+// Parâmetros de solve: seed, method (nearest|insertion|savings|ils), vnd (0|1), max-iter, max-iter-ils,
+// alpha-min, alpha-max, perturb-strength, time-limit (segundos), threads, batch, grasp-threads,
+// elite, relink-every, relink-pairs, penalized (0|1), penalty-target,
+// resequence (0|1), progress (0|1).
+// Retorna o código de saída do processo.
+int RunDaemon(const DaemonOptions& options);
+
+#endif
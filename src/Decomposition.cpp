@@ -0,0 +1,386 @@
+#include "Decomposition.h"
+#include "Feasibility.h"
+#include "Parallel.h"
+#include "Rng.h"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Vizinhos de cada estação que contam como ligação entre duas rotas
+constexpr int kProximityNeighbors = 8;
+
+struct Subproblem {
+    std::vector<int> routes;      // índices das rotas na solução atual (a semente primeiro)
+    int vehicles = 0;             // frota da sub-instância: as rotas dela e a sua parte dos veículos livres
+    bool split = false;           // semente maior que max_stations: otimizada sozinha, trecho a trecho
+    std::vector<Route> result;    // rotas novas, ids originais (se improved)
+    bool improved = false;
+};
+
+int RouteStations(const Route& route) {
+    return static_cast<int>(route.nodes.size()) - 2;
+}
+
+// A semente e as rotas com mais ligações a ela (estação da semente com a outra rota entre seus
+// kProximityNeighbors vizinhos mais próximos), enquanto couberem em max_stations. Rotas já
+// usadas na rodada (`taken`) ficam de fora. Uma semente que sozinha passa de max_stations
+// volta sem companhia e é dividida em trechos (SolveSplitRoute).
+std::vector<int> SelectRoutes(const Data& data, const Solution& solution, const std::vector<int>& route_of,
+                              int seed, int max_stations, const std::vector<char>& taken) {
+    std::vector<int> links(solution.routes.size(), 0);
+    const Route& seed_route = solution.routes[seed];
+    for (size_t i = 1; i + 1 < seed_route.nodes.size(); ++i) {
+        const std::vector<int>& neighbors = data.getNeighbors(seed_route.nodes[i]);
+        int count = std::min(kProximityNeighbors, static_cast<int>(neighbors.size()));
+        for (int k = 0; k < count; ++k) {
+            int r = route_of[neighbors[k]];
+            if (r >= 0 && r != seed && !taken[r]) {
+                links[r]++;
+            }
+        }
+    }
+
+    std::vector<int> candidates;
+    for (int r = 0; r < static_cast<int>(links.size()); ++r) {
+        if (links[r] > 0) candidates.push_back(r);
+    }
+    std::sort(candidates.begin(), candidates.end(), [&](int a, int b) {
+        if (links[a] != links[b]) return links[a] > links[b];
+        return a < b;
+    });
+
+    std::vector<int> selected{seed};
+    int size = RouteStations(seed_route);
+    if (size > max_stations) {
+        return selected;
+    }
+    for (int r : candidates) {
+        int stations = RouteStations(solution.routes[r]);
+        if (size + stations <= max_stations) {
+            selected.push_back(r);
+            size += stations;
+        }
+    }
+    return selected;
+}
+
+// Otimiza as estações route.nodes[first..last] de uma rota com o resto dela fixo, numa
+// sub-instância de um veículo cuja rota é 0 → E → trecho → X → 0. As âncoras E e X fazem o papel
+// dos nós antes e depois do trecho: só os arcos 0 → E e X → 0 saem ou chegam ao depósito sem
+// custo proibitivo, então nenhuma solução melhor que a inicial tira as âncoras das pontas. As
+// demandas delas trazem a carga de fora do trecho: com o prefixo de entrada o e os extremos M e
+// m dos prefixos de fora, E = o - M e X = m - (prefixo na saída), e os prefixos da sub-rota,
+// deslocados de M - o, são {M - o, m - o, 0, prefixos do trecho} — a mesma condição de carga da
+// rota inteira. Devolve se o trecho melhorou (e route mudou).
+bool SolveSegment(const Data& data, Route& route, size_t first, size_t last, std::mt19937& rng,
+                  const ILSParams& ils_params) {
+    const int length = static_cast<int>(route.nodes.size()) - 2;
+    std::vector<long long> prefix(length + 1, 0);
+    for (int t = 1; t <= length; ++t) {
+        prefix[t] = prefix[t - 1] + NodeDemand(data, route.nodes[t]);
+    }
+    long long outside_max = 0;
+    long long outside_min = 0;
+    for (int t = 0; t <= length; ++t) {
+        if (t + 1 >= static_cast<int>(first) && t < static_cast<int>(last)) continue;
+        outside_max = std::max(outside_max, prefix[t]);
+        outside_min = std::min(outside_min, prefix[t]);
+    }
+
+    // Nós da sub-instância: 0 depósito, 1 = E, 2..k-1 as estações do trecho, k = X
+    const int k = static_cast<int>(last - first) + 3;
+    const int entry = 1;
+    const int exit = k;
+    std::vector<int> nodes(k + 1, 0);
+    nodes[entry] = route.nodes[first - 1];
+    nodes[exit] = route.nodes[last + 1];
+    for (size_t i = first; i <= last; ++i) {
+        nodes[static_cast<int>(i - first) + 2] = route.nodes[i];
+    }
+
+    std::vector<long long> demands(k);
+    demands[entry - 1] = prefix[first - 1] - outside_max;
+    demands[exit - 1] = outside_min - prefix[last];
+    for (int i = 2; i < exit; ++i) {
+        demands[i - 1] = NodeDemand(data, nodes[i]);
+    }
+
+    double max_cost = 0.0;
+    for (int i = 1; i <= k; ++i) {
+        for (int j = 1; j <= k; ++j) {
+            max_cost = std::max(max_cost, data.getTravelCost(nodes[i], nodes[j]));
+        }
+    }
+    const double forbidden = (k + 2) * (max_cost + 1.0);
+    std::vector<double> costs(static_cast<size_t>(k + 1) * (k + 1), 0.0);
+    for (int i = 0; i <= k; ++i) {
+        for (int j = 0; j <= k; ++j) {
+            double& cost = costs[static_cast<size_t>(i) * (k + 1) + j];
+            if (i == j) continue;
+            if (i == 0 || j == 0) {
+                cost = (i == 0 && j == entry) || (i == exit && j == 0) ? 0.0 : forbidden;
+            } else if (j == entry || i == exit) {
+                cost = forbidden;
+            } else {
+                cost = data.getTravelCost(nodes[i], nodes[j]);
+            }
+        }
+    }
+    Data sub_data(data.getInstanceName() + "-seg", k, 1, data.getVehicleCapacity(), demands, costs);
+
+    Solution sub_start;
+    Route path;
+    for (int i = 0; i <= k; ++i) {
+        path.nodes.push_back(i);
+    }
+    path.nodes.push_back(0);
+    sub_start.routes.push_back(std::move(path));
+    sub_start.total_cost = SolutionCost(sub_data, sub_start);
+    Solution best = ILS(sub_data, rng, ils_params, false, &sub_start);
+
+    if (best.total_cost >= sub_start.total_cost - 1e-9 || best.routes.size() != 1 ||
+        !CheckSolutionFeasible(sub_data, best.routes)) {
+        return false;
+    }
+    const std::vector<int>& order = best.routes[0].nodes;
+    if (order[1] != entry || order[order.size() - 2] != exit) {
+        return false;
+    }
+    for (size_t i = first; i <= last; ++i) {
+        route.nodes[i] = nodes[order[i - first + 2]];
+    }
+    return true;
+}
+
+// Semente longa demais para um subproblema: a rota é cortada em trechos consecutivos de até
+// max_stations estações, otimizados um a um com as pontas fixas (SolveSegment). O primeiro
+// corte é sorteado, para que uma rota que volta a ser semente tenha outras fronteiras.
+void SolveSplitRoute(const Data& data, const Solution& solution, Subproblem& sub, std::mt19937 rng,
+                     const ILSParams& ils_params, int max_stations, const std::function<double()>& time_left) {
+    Route route = solution.routes[sub.routes.front()];
+    const int length = RouteStations(route);
+    const int pieces = (length + max_stations - 1) / max_stations;
+    const int size = (length + pieces - 1) / pieces;
+    const int shift = std::uniform_int_distribution<int>(0, size - 1)(rng);
+
+    bool improved = false;
+    for (int start = 1 + shift - (shift > 0 ? size : 0); start <= length; start += size) {
+        const int begin = std::max(1, start);
+        const int end = std::min(length, start + size - 1);
+        if (end - begin < 1) continue;
+        ILSParams params = ils_params;
+        params.time_limit = time_left();
+        if (params.time_limit < 0.0) break;
+        improved |= SolveSegment(data, route, static_cast<size_t>(begin), static_cast<size_t>(end), rng, params);
+    }
+
+    if (improved && CheckRouteFeasible(data, route).ok) {
+        sub.result.push_back(std::move(route));
+        sub.improved = true;
+    }
+}
+
+// Resolve o subproblema numa instância própria: nós 0 (depósito) e as estações das rotas
+// selecionadas renumeradas 1..k, com a matriz (k+1) x (k+1) copiada da original
+void SolveSubproblem(const Data& data, const Solution& solution, Subproblem& sub, std::mt19937 rng,
+                     const ILSParams& ils_params, const std::function<double()>& time_left) {
+    ILSParams params = ils_params;
+    params.time_limit = time_left();
+    if (params.time_limit < 0.0) return;
+
+    std::vector<int> nodes{0};
+    Solution sub_start;
+    for (int r : sub.routes) {
+        Route route;
+        route.nodes.push_back(0);
+        const Route& original = solution.routes[r];
+        for (size_t i = 1; i + 1 < original.nodes.size(); ++i) {
+            route.nodes.push_back(static_cast<int>(nodes.size()));
+            nodes.push_back(original.nodes[i]);
+        }
+        route.nodes.push_back(0);
+        sub_start.routes.push_back(std::move(route));
+    }
+
+    const int k = static_cast<int>(nodes.size()) - 1;
+    std::vector<long long> demands(k);
+    for (int i = 1; i <= k; ++i) {
+        demands[i - 1] = NodeDemand(data, nodes[i]);
+    }
+    std::vector<double> costs(static_cast<size_t>(k + 1) * (k + 1));
+    for (int i = 0; i <= k; ++i) {
+        for (int j = 0; j <= k; ++j) {
+            costs[static_cast<size_t>(i) * (k + 1) + j] = data.getTravelCost(nodes[i], nodes[j]);
+        }
+    }
+    Data sub_data(data.getInstanceName() + "-sub", k, sub.vehicles, data.getVehicleCapacity(), demands, costs);
+
+    sub_start.total_cost = SolutionCost(sub_data, sub_start);
+    Solution best = ILS(sub_data, rng, params, false, &sub_start);
+
+    int covered = 0;
+    for (const Route& route : best.routes) {
+        covered += RouteStations(route);
+    }
+    if (best.total_cost >= sub_start.total_cost - 1e-9 || covered != k ||
+        !CheckSolutionFeasible(sub_data, best.routes)) {
+        return;
+    }
+
+    for (Route& route : best.routes) {
+        if (RouteStations(route) == 0) continue;
+        for (int& v : route.nodes) {
+            v = nodes[v];
+        }
+        sub.result.push_back(std::move(route));
+    }
+    sub.improved = true;
+}
+
+} // namespace
+
+Solution Decompose(const Data& data, const Solution& start, std::mt19937& rng, const DecompositionParams& p,
+                   bool verbose) {
+    auto start_time = std::chrono::steady_clock::now();
+    // Tempo que resta (0 = sem limite, negativo = esgotado ou cancelado). Vira o time_limit do
+    // ILS de cada subproblema, para que uma rodada em curso também pare em p.time_limit
+    const std::function<double()> time_left = [&]() {
+        if (p.ils.cancel && p.ils.cancel->load(std::memory_order_relaxed)) return -1.0;
+        if (p.time_limit <= 0.0) return 0.0;
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_time;
+        return elapsed.count() >= p.time_limit ? -1.0 : p.time_limit - elapsed.count();
+    };
+    auto out_of_time = [&]() { return time_left() < 0.0; };
+
+    TraceSink* trace = p.ils.trace;
+    ILSParams ils_params = p.ils;
+    ils_params.threads = 0;
+    ils_params.trace = nullptr;
+    ils_params.on_improvement = nullptr;
+
+    const int n = data.getNumStations();
+    const uint64_t base_seed = (static_cast<uint64_t>(rng()) << 32) | rng();
+
+    Solution current = start;
+    current.total_cost = SolutionCost(data, current);
+    std::vector<char> pending(current.routes.size(), 1);
+
+    long long solved = 0;
+    long long improved_total = 0;
+    int round = 0;
+    while (!out_of_time()) {
+        std::vector<int> route_of(n + 1, -1);
+        for (int r = 0; r < static_cast<int>(current.routes.size()); ++r) {
+            for (size_t i = 1; i + 1 < current.routes[r].nodes.size(); ++i) {
+                route_of[current.routes[r].nodes[i]] = r;
+            }
+        }
+
+        // Até `batch` subproblemas disjuntos, sementes pendentes em ordem de índice
+        std::vector<Subproblem> subs;
+        std::vector<char> taken(current.routes.size(), 0);
+        for (int r = 0; r < static_cast<int>(current.routes.size()) && static_cast<int>(subs.size()) < p.batch; ++r) {
+            if (!pending[r] || taken[r]) continue;
+            Subproblem sub;
+            sub.routes = SelectRoutes(data, current, route_of, r, p.max_stations, taken);
+            sub.split = RouteStations(current.routes[r]) > p.max_stations;
+            for (int s : sub.routes) {
+                taken[s] = 1;
+            }
+            subs.push_back(std::move(sub));
+        }
+        if (subs.empty()) {
+            break;
+        }
+
+        // Veículos não usados pela solução atual, repartidos entre os subproblemas da rodada (os
+        // de rota dividida continuam com um só) para que a soma das rotas novas não passe de m
+        int used = 0;
+        for (const Route& route : current.routes) {
+            if (RouteStations(route) > 0) used++;
+        }
+        const int spare = std::max(0, data.getNumVehicles() - used);
+        const int count = static_cast<int>(std::count_if(subs.begin(), subs.end(),
+                                                         [](const Subproblem& sub) { return !sub.split; }));
+        for (int k = 0, share = 0; k < static_cast<int>(subs.size()); ++k) {
+            subs[k].vehicles = static_cast<int>(subs[k].routes.size());
+            if (!subs[k].split) {
+                subs[k].vehicles += spare / count + (share < spare % count ? 1 : 0);
+                share++;
+            }
+        }
+
+        ParallelFor(static_cast<int>(subs.size()), std::max(1, p.threads), [&](int k) {
+            PhaseTimer timer(trace, "subproblem");
+            std::mt19937 sub_rng = MakeStreamRng(base_seed, static_cast<uint64_t>(solved + k));
+            if (subs[k].split) {
+                SolveSplitRoute(data, current, subs[k], sub_rng, ils_params, p.max_stations, time_left);
+            } else {
+                SolveSubproblem(data, current, subs[k], sub_rng, ils_params, time_left);
+            }
+        });
+
+        // Rotas de subproblemas melhorados são trocadas (na posição da semente) pelas novas, que
+        // voltam a ser sementes; a semente de um subproblema sem melhoria deixa de ser
+        std::vector<int> replaced_by(current.routes.size(), -1);
+        int improved_round = 0;
+        for (int k = 0; k < static_cast<int>(subs.size()); ++k) {
+            if (subs[k].improved) {
+                for (int r : subs[k].routes) {
+                    replaced_by[r] = k;
+                }
+                improved_round++;
+            } else {
+                pending[subs[k].routes.front()] = 0;
+            }
+        }
+
+        std::vector<Route> routes;
+        std::vector<char> next_pending;
+        for (int r = 0; r < static_cast<int>(current.routes.size()); ++r) {
+            int k = replaced_by[r];
+            if (k < 0) {
+                routes.push_back(std::move(current.routes[r]));
+                next_pending.push_back(pending[r]);
+            } else if (subs[k].routes.front() == r) {
+                for (Route& route : subs[k].result) {
+                    routes.push_back(std::move(route));
+                    next_pending.push_back(1);
+                }
+            }
+        }
+        current.routes = std::move(routes);
+        pending = std::move(next_pending);
+        current.total_cost = SolutionCost(data, current);
+
+        solved += static_cast<long long>(subs.size());
+        improved_total += improved_round;
+        round++;
+        if (improved_round > 0) {
+            if (trace) trace->improvement(solved, round, 0.0, "decompose", current.total_cost);
+            if (p.ils.on_improvement) p.ils.on_improvement(current);
+        }
+        if (verbose) {
+            int remaining = static_cast<int>(std::count(pending.begin(), pending.end(), 1));
+            std::cout << "Rodada " << round << ": " << subs.size() << " subproblemas, " << improved_round
+                      << " melhoraram, custo = " << current.total_cost << ", sementes pendentes = " << remaining
+                      << std::endl;
+        }
+    }
+
+    if (trace) {
+        trace->addCounter("subproblems", static_cast<double>(solved));
+        trace->addCounter("subproblems_improved", static_cast<double>(improved_total));
+    }
+    if (verbose) {
+        std::cout << "Decomposição: " << solved << " subproblemas em " << round << " rodadas, " << improved_total
+                  << " melhoraram" << std::endl;
+    }
+    return current;
+}
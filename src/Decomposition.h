@@ -0,0 +1,33 @@
+#ifndef DECOMPOSITION_H
+#define DECOMPOSITION_H
+
+#include <random>
+#include "Construction.h"
+#include "ILS.h"
+#include "Instance.h"
+
+struct DecompositionParams {
+    int    max_stations = 100;  // estações por subproblema (uma semente maior é dividida em trechos)
+    int    batch        = 8;    // subproblemas disjuntos resolvidos por rodada
+    int    threads      = 1;    // threads resolvendo os subproblemas de uma rodada
+    double time_limit   = 0.0;  // segundos; 0 = sem limite
+
+    // ILS de cada subproblema (threads, trace e on_improvement são ignorados, e time_limit vira
+    // o que resta de p.time_limit);
+    // `trace` registra as rodadas da decomposição, on_improvement recebe a solução após cada
+    // rodada que melhorou e `cancel` interrompe a decomposição e os subproblemas em curso
+    ILSParams ils;
+};
+
+// Decomposição no estilo POPMUSIC: as partes são as rotas. Cada subproblema é uma rota semente
+// mais as rotas mais ligadas a ela pelas listas de vizinhos das suas estações, até
+// max_stations estações; vira uma instância compacta (matriz só dos seus nós), é otimizado
+// pelo ILS partindo das rotas atuais e volta para a solução se o custo caiu. Uma semente com
+// mais de max_stations estações é otimizada sozinha, em trechos consecutivos de até
+// max_stations estações com as pontas e a carga de fora do trecho fixas. Rotas alteradas
+// voltam a ser sementes pendentes; termina quando nenhuma semente pendente melhora. Os
+// subproblemas de uma rodada são disjuntos e o resultado não depende de `threads`.
+[[nodiscard]] Solution Decompose(const Data& data, const Solution& start, std::mt19937& rng,
+                                 const DecompositionParams& p, bool verbose);
+
+#endif
@@ -1,5 +1,6 @@
 #include "Feasibility.h"
 #include <algorithm>
+#include <limits>
 
 long long NodeDemand(const Data& data, int node) {
     if (node == 0) {
@@ -92,3 +93,106 @@ bool CheckSolutionFeasible(const Data& data, const std::vector<Route>& sol) {
     
     return true;
 }
+
+void BuildLoadProfile(const Data& data, const Route& route, RouteLoadProfile& profile) {
+    const size_t k = route.nodes.size() >= 2 ? route.nodes.size() - 2 : 0;
+
+    profile.prefix.resize(k + 1);
+    profile.pre_max.resize(k + 1);
+    profile.pre_min.resize(k + 1);
+    profile.suf_max.resize(k + 2);
+    profile.suf_min.resize(k + 2);
+
+    profile.prefix[0] = profile.pre_max[0] = profile.pre_min[0] = 0;
+    for (size_t i = 1; i <= k; ++i) {
+        profile.prefix[i] = profile.prefix[i - 1] + NodeDemand(data, route.nodes[i]);
+        profile.pre_max[i] = std::max(profile.pre_max[i - 1], profile.prefix[i]);
+        profile.pre_min[i] = std::min(profile.pre_min[i - 1], profile.prefix[i]);
+    }
+
+    profile.suf_max[k + 1] = std::numeric_limits<long long>::min() / 2;
+    profile.suf_min[k + 1] = std::numeric_limits<long long>::max() / 2;
+    for (size_t i = k; i >= 1; --i) {
+        profile.suf_max[i] = std::max(profile.suf_max[i + 1], profile.prefix[i]);
+        profile.suf_min[i] = std::min(profile.suf_min[i + 1], profile.prefix[i]);
+    }
+}
+
+bool CanInsertAt(const RouteLoadProfile& profile, size_t pos, long long demand, long long Q) {
+    // Prefixos antes de pos ficam iguais; o novo prefixo e todos os seguintes deslocam de `demand`
+    long long inserted = profile.prefix[pos - 1] + demand;
+    long long max_prefix = std::max({profile.pre_max[pos - 1], inserted, profile.suf_max[pos] + demand});
+    long long min_prefix = std::min({profile.pre_min[pos - 1], inserted, profile.suf_min[pos] + demand});
+    return std::max(0LL, -min_prefix) <= Q - max_prefix;
+}
+
+bool CanRemoveAt(const RouteLoadProfile& profile, size_t pos, long long demand, long long Q) {
+    // Prefixos antes de pos ficam iguais; os seguintes deslocam de -demand
+    long long max_prefix = std::max(profile.pre_max[pos - 1], profile.suf_max[pos + 1] - demand);
+    long long min_prefix = std::min(profile.pre_min[pos - 1], profile.suf_min[pos + 1] - demand);
+    return std::max(0LL, -min_prefix) <= Q - max_prefix;
+}
+
+bool CanRemoveSegment(const RouteLoadProfile& profile, size_t first, size_t last, long long demand, long long Q) {
+    long long max_prefix = std::max(profile.pre_max[first - 1], profile.suf_max[last + 1] - demand);
+    long long min_prefix = std::min(profile.pre_min[first - 1], profile.suf_min[last + 1] - demand);
+    return std::max(0LL, -min_prefix) <= Q - max_prefix;
+}
+
+bool CanReplaceAt(const RouteLoadProfile& profile, size_t pos, long long delta, long long Q) {
+    // Prefixos a partir de pos deslocam de delta
+    long long max_prefix = std::max(profile.pre_max[pos - 1], profile.suf_max[pos] + delta);
+    long long min_prefix = std::min(profile.pre_min[pos - 1], profile.suf_min[pos] + delta);
+    return std::max(0LL, -min_prefix) <= Q - max_prefix;
+}
+
+bool CanReverseSegment(const RouteLoadProfile& profile, size_t first, size_t last, long long Q) {
+    // Após m estações do trecho invertido o prefixo é prefix[first-1] + prefix[last] - prefix[last-m];
+    // fora do trecho nada muda
+    long long max_prefix = std::max(profile.pre_max[first - 1], profile.suf_max[last + 1]);
+    long long min_prefix = std::min(profile.pre_min[first - 1], profile.suf_min[last + 1]);
+    long long base = profile.prefix[first - 1] + profile.prefix[last];
+    for (size_t k = first - 1; k < last; ++k) {
+        max_prefix = std::max(max_prefix, base - profile.prefix[k]);
+        min_prefix = std::min(min_prefix, base - profile.prefix[k]);
+    }
+    return std::max(0LL, -min_prefix) <= Q - max_prefix;
+}
+
+RouteLoadWindow LoadWindowOf(const Data& data, const Route& route) {
+    RouteLoadWindow w;
+    for (size_t i = 1; i + 1 < route.nodes.size(); ++i) {
+        w.total += NodeDemand(data, route.nodes[i]);
+        w.max_prefix = std::max(w.max_prefix, w.total);
+        w.min_prefix = std::min(w.min_prefix, w.total);
+    }
+    return w;
+}
+
+RouteLoadWindow ConcatWindows(const RouteLoadWindow& a, const RouteLoadWindow& b) {
+    return {a.total + b.total, std::max(a.max_prefix, a.total + b.max_prefix),
+            std::min(a.min_prefix, a.total + b.min_prefix)};
+}
+
+bool WindowFits(const RouteLoadWindow& w, long long Q) {
+    return std::max(0LL, -w.min_prefix) <= Q - w.max_prefix;
+}
+
+bool CanInsertSegmentAt(const RouteLoadProfile& profile, size_t pos, const RouteLoadWindow& block, long long Q) {
+    long long before = profile.prefix[pos - 1];
+    long long max_prefix = std::max({profile.pre_max[pos - 1], before + block.max_prefix,
+                                     profile.suf_max[pos] + block.total});
+    long long min_prefix = std::min({profile.pre_min[pos - 1], before + block.min_prefix,
+                                     profile.suf_min[pos] + block.total});
+    return std::max(0LL, -min_prefix) <= Q - max_prefix;
+}
+
+bool MayShiftSuffix(const RouteLoadWindow& w, long long delta, long long Q) {
+    // Cada prefixo antigo aparece deslocado ou não; o último (total) sempre deslocado.
+    // Logo o novo máximo é pelo menos max_prefix + min(0, delta) e o novo mínimo no máximo
+    // min_prefix + max(0, delta).
+    long long shifted_total = w.total + delta;
+    long long hi = std::max({0LL, shifted_total, w.max_prefix + std::min(0LL, delta)});
+    long long lo = std::min({0LL, shifted_total, w.min_prefix + std::max(0LL, delta)});
+    return hi - lo <= Q;
+}
@@ -18,9 +18,54 @@ struct RouteFeasInfo {
     long long suggested_L0 = 0;
 };
 
+// Perfil de carga de uma rota 0 -> r1 -> ... -> rk -> 0: prefix[i] é a soma das demandas
+// de r1..ri (prefix[0] = 0), com máximos/mínimos acumulados à esquerda (pre_*) e à direita
+// (suf_*, suf_*[k+1] neutro). Permite testar a inserção de uma estação em qualquer posição
+// em O(1), sem copiar a rota.
+struct RouteLoadProfile {
+    std::vector<long long> prefix;
+    std::vector<long long> pre_max;
+    std::vector<long long> pre_min;
+    std::vector<long long> suf_max;
+    std::vector<long long> suf_min;
+};
+
+// Janela de carga de uma rota: demanda total e extremos de prefixo (ambos incluem 0). A rota
+// é viável sse max_prefix - min_prefix <= Q, e a janela da concatenação A+B sai de A e B em O(1).
+struct RouteLoadWindow {
+    long long total = 0;
+    long long max_prefix = 0;
+    long long min_prefix = 0;
+};
+
 RouteFeasInfo CheckRouteFeasible(const Data& data, const Route& route);
 bool         CheckSolutionFeasible(const Data& data, const std::vector<Route>& sol);
 
 long long    NodeDemand(const Data& data, int node);
 
+void         BuildLoadProfile(const Data& data, const Route& route, RouteLoadProfile& profile);
+// Inserir uma estação de demanda `demand` antes de route.nodes[pos] (1 <= pos <= k+1) mantém a rota viável?
+bool         CanInsertAt(const RouteLoadProfile& profile, size_t pos, long long demand, long long Q);
+// Remover a estação route.nodes[pos] (1 <= pos <= k, demanda `demand`) mantém a rota viável?
+bool         CanRemoveAt(const RouteLoadProfile& profile, size_t pos, long long demand, long long Q);
+// Remover o trecho route.nodes[first..last] (demanda total `demand`) mantém a rota viável?
+bool         CanRemoveSegment(const RouteLoadProfile& profile, size_t first, size_t last, long long demand,
+                              long long Q);
+// Trocar route.nodes[pos] por uma estação com demanda `delta` a mais mantém a rota viável?
+bool         CanReplaceAt(const RouteLoadProfile& profile, size_t pos, long long delta, long long Q);
+// Inverter o trecho route.nodes[first..last] mantém a rota viável? O(last - first)
+bool         CanReverseSegment(const RouteLoadProfile& profile, size_t first, size_t last, long long Q);
+
+RouteLoadWindow LoadWindowOf(const Data& data, const Route& route);
+RouteLoadWindow ConcatWindows(const RouteLoadWindow& a, const RouteLoadWindow& b);
+bool            WindowFits(const RouteLoadWindow& w, long long Q);
+// Inserir um trecho de janela `block` antes de route.nodes[pos] (1 <= pos <= k+1) mantém a rota viável?
+bool            CanInsertSegmentAt(const RouteLoadProfile& profile, size_t pos, const RouteLoadWindow& block,
+                                   long long Q);
+// Filtro O(1), condição necessária: somar `delta` a um sufixo dos prefixos da rota (que inclua
+// o último) pode deixá-la viável? Cobre inserir uma estação de demanda delta em qualquer
+// posição e trocar uma estação por outra cuja demanda difere de delta. false => nenhuma
+// posição serve; true não garante viabilidade.
+bool            MayShiftSuffix(const RouteLoadWindow& w, long long delta, long long Q);
+
 #endif
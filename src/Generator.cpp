@@ -0,0 +1,130 @@
+#include "Generator.h"
+#include "Rng.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+// SplitMix64: saída totalmente especificada, base de todas as distribuições abaixo
+class PortableRng {
+public:
+    explicit PortableRng(uint64_t seed) : state(seed) {}
+
+    uint64_t next() { return SplitMix64(state); }
+
+    double uniform() { return static_cast<double>(next() >> 11) * 0x1.0p-53; }
+
+    // Inteiro uniforme em [lo, hi] sem viés de módulo
+    long long range(long long lo, long long hi) {
+        uint64_t span = static_cast<uint64_t>(hi - lo) + 1;
+        uint64_t limit = UINT64_MAX - UINT64_MAX % span;
+        uint64_t x;
+        do {
+            x = next();
+        } while (x >= limit);
+        return lo + static_cast<long long>(x % span);
+    }
+
+    double normal() {
+        double u1 = uniform();
+        double u2 = uniform();
+        if (u1 < 1e-300) {
+            u1 = 1e-300;
+        }
+        return std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * M_PI * u2);
+    }
+
+private:
+    uint64_t state;
+};
+
+std::vector<long long> GenerateDemands(const GeneratorParams& p, PortableRng& rng) {
+    const long long dmax = p.demand_max > 0 ? p.demand_max : std::max(1, p.Q / 2);
+    std::vector<long long> demands(p.n);
+
+    if (p.demand_dist == "bimodal") {
+        // Estações quase cheias ou quase vazias: |q| concentrado perto de dmax
+        for (auto& d : demands) {
+            long long magnitude = rng.range(std::max(1LL, dmax / 2), dmax);
+            d = (rng.next() & 1) ? magnitude : -magnitude;
+        }
+    } else {
+        for (auto& d : demands) {
+            d = rng.range(-dmax, dmax);
+        }
+    }
+
+    if (p.demand_dist == "balanced" && p.n > 0) {
+        // Distribui o excesso entre estações aleatórias até que a soma seja zero
+        long long total = 0;
+        for (long long d : demands) {
+            total += d;
+        }
+        while (total != 0) {
+            long long& d = demands[static_cast<size_t>(rng.range(0, p.n - 1))];
+            long long step = total > 0 ? -1 : 1;
+            if (std::llabs(d + step) <= dmax) {
+                d += step;
+                total += step;
+            }
+        }
+    }
+
+    return demands;
+}
+
+} // namespace
+
+std::string GeneratedInstanceName(const GeneratorParams& params) {
+    return "gen_n" + std::to_string(params.n) + "_q" + std::to_string(params.Q) + "_" + params.geometry + "_s" +
+           std::to_string(params.seed);
+}
+
+std::unique_ptr<Data> GenerateInstance(const GeneratorParams& p) {
+    PortableRng rng(p.seed);
+    const int n = p.n;
+    const int matrix_size = n + 1;
+
+    // Depósito no centro; estações uniformes ou em torno de centros de cluster
+    std::vector<double> xs(matrix_size), ys(matrix_size);
+    xs[0] = ys[0] = p.side / 2.0;
+
+    if (p.geometry == "clustered") {
+        int k = std::max(1, p.clusters);
+        std::vector<double> cx(k), cy(k);
+        for (int c = 0; c < k; ++c) {
+            cx[c] = rng.uniform() * p.side;
+            cy[c] = rng.uniform() * p.side;
+        }
+        for (int i = 1; i < matrix_size; ++i) {
+            int c = static_cast<int>(rng.range(0, k - 1));
+            xs[i] = std::clamp(cx[c] + p.spread * rng.normal(), 0.0, p.side);
+            ys[i] = std::clamp(cy[c] + p.spread * rng.normal(), 0.0, p.side);
+        }
+    } else {
+        for (int i = 1; i < matrix_size; ++i) {
+            xs[i] = rng.uniform() * p.side;
+            ys[i] = rng.uniform() * p.side;
+        }
+    }
+
+    std::vector<long long> demands = GenerateDemands(p, rng);
+
+    std::vector<double> costs(static_cast<size_t>(matrix_size) * matrix_size, 0.0);
+    for (int i = 0; i < matrix_size; ++i) {
+        for (int j = 0; j < matrix_size; ++j) {
+            if (i == j) {
+                continue;
+            }
+            double dist = std::hypot(xs[i] - xs[j], ys[i] - ys[j]);
+            if (p.asymmetry > 0.0) {
+                dist *= 1.0 + p.asymmetry * rng.uniform();
+            }
+            costs[static_cast<size_t>(i) * matrix_size + j] = std::round(dist);
+        }
+    }
+
+    int m = p.m > 0 ? p.m : n;
+    return std::make_unique<Data>(GeneratedInstanceName(p), n, m, p.Q, demands, costs);
+}
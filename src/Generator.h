@@ -0,0 +1,30 @@
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "Instance.h"
+
+// Parâmetros do gerador de instâncias sintéticas. Com a mesma semente o resultado é
+// idêntico em qualquer plataforma: o gerador não usa as distribuições de <random>,
+// cuja implementação varia entre bibliotecas padrão.
+struct GeneratorParams {
+    int          n            = 100;
+    int          m            = 0;      // 0 => m = n
+    int          Q            = 20;
+    uint64_t     seed         = 42;
+    std::string  demand_dist  = "uniform";   // "uniform", "balanced" ou "bimodal"
+    int          demand_max   = 0;      // 0 => Q / 2
+    std::string  geometry     = "uniform";   // "uniform" ou "clustered"
+    int          clusters     = 8;
+    double       spread       = 40.0;   // desvio padrão dos clusters
+    double       side         = 1000.0; // lado do quadrado
+    double       asymmetry    = 0.0;    // c(i,j) = d(i,j) * (1 + asymmetry * u), u em [0,1)
+};
+
+[[nodiscard]] std::unique_ptr<Data> GenerateInstance(const GeneratorParams& params);
+
+[[nodiscard]] std::string GeneratedInstanceName(const GeneratorParams& params);
+
+#endif
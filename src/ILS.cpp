@@ -1,149 +1,355 @@
 #include "ILS.h"
 #include "Feasibility.h"
+#include "Parallel.h"
+#include "PathRelinking.h"
+#include "PenalizedSearch.h"
+#include "ProcStats.h"
+#include "Resequence.h"
+#include "Rng.h"
+#include "Trace.h"
+#include "Verify.h"
 #include <iostream>
 #include <algorithm>
+#include <atomic>
 #include <limits>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+// "origem+vizinhança": quem gerou o ponto de partida e a última vizinhança que melhorou
+static std::string OperatorLabel(const std::string& source, const RVNDStats& stats) {
+    return stats.last_improving ? source + "+" + stats.last_improving : source;
+}
+
+// Buscas locais (RVND) ao longo de cada caminho de path relinking
+static constexpr int kRelinkSearchPoints = 3;
 
 static double SampleAlpha(std::mt19937& rng, double alpha_min, double alpha_max) {
     std::uniform_real_distribution<double> dist(alpha_min, alpha_max);
     return dist(rng);
 }
 
-static void ApplyRandomPerturbation(const Data& data, Solution& solution,
-                                    std::mt19937& rng, int strength) {
-    if (solution.routes.empty()) return;
+// Sorteios de estratégia/posições por perturbação antes de desistir
+static constexpr int kPerturbAttempts = 8;
+
+// Cada perturbação devolve em `delta` a variação de custo dos arcos trocados (conferida por --verify)
+
+// Move um bloco de até `strength` estações para outra rota, numa posição viável sorteada
+static bool TryBlockRelocate(const Data& data, Solution& solution, std::mt19937& rng, int strength, double& delta) {
+    if (solution.routes.size() < 2) return false;
+    const long long Q = data.getVehicleCapacity();
+
+    std::uniform_int_distribution<size_t> route_dist(0, solution.routes.size() - 1);
+    size_t from_route_idx, to_route_idx;
+    do {
+        from_route_idx = route_dist(rng);
+        to_route_idx = route_dist(rng);
+    } while (from_route_idx == to_route_idx);
+
+    Route& from_route = solution.routes[from_route_idx];
+    Route& to_route = solution.routes[to_route_idx];
+
+    if (from_route.nodes.size() <= 2) return false;
+
+    int available_stations = static_cast<int>(from_route.nodes.size()) - 2;
+    int block_size = std::min(strength, std::max(1, available_stations / 2));
+    std::uniform_int_distribution<int> size_dist(1, std::min(block_size, available_stations));
+    int selected_size = size_dist(rng);
+
+    std::uniform_int_distribution<size_t> start_dist(1, from_route.nodes.size() - 1 - selected_size);
+    size_t start_pos = start_dist(rng);
+    size_t end_pos = start_pos + selected_size - 1;
+
+    RouteLoadWindow block;
+    for (size_t i = start_pos; i <= end_pos; ++i) {
+        block.total += NodeDemand(data, from_route.nodes[i]);
+        block.max_prefix = std::max(block.max_prefix, block.total);
+        block.min_prefix = std::min(block.min_prefix, block.total);
+    }
+
+    RouteLoadProfile from_profile;
+    BuildLoadProfile(data, from_route, from_profile);
+    if (!CanRemoveSegment(from_profile, start_pos, end_pos, block.total, Q)) return false;
+
+    RouteLoadProfile to_profile;
+    BuildLoadProfile(data, to_route, to_profile);
+    std::vector<size_t> positions;
+    for (size_t pos = 1; pos < to_route.nodes.size(); ++pos) {
+        if (CanInsertSegmentAt(to_profile, pos, block, Q)) {
+            positions.push_back(pos);
+        }
+    }
+    if (positions.empty()) return false;
+
+    std::uniform_int_distribution<size_t> pos_dist(0, positions.size() - 1);
+    size_t insert_pos = positions[pos_dist(rng)];
+
+    const std::vector<int>& from = from_route.nodes;
+    const std::vector<int>& to = to_route.nodes;
+    delta = data.getTravelCost(from[start_pos - 1], from[end_pos + 1]) -
+            data.getTravelCost(from[start_pos - 1], from[start_pos]) - data.getTravelCost(from[end_pos], from[end_pos + 1]) +
+            data.getTravelCost(to[insert_pos - 1], from[start_pos]) + data.getTravelCost(from[end_pos], to[insert_pos]) -
+            data.getTravelCost(to[insert_pos - 1], to[insert_pos]);
+
+    std::vector<int> moved(from_route.nodes.begin() + start_pos, from_route.nodes.begin() + end_pos + 1);
+    from_route.nodes.erase(from_route.nodes.begin() + start_pos, from_route.nodes.begin() + end_pos + 1);
+    to_route.nodes.insert(to_route.nodes.begin() + insert_pos, moved.begin(), moved.end());
+    return true;
+}
+
+// Troca uma estação sorteada por um parceiro sorteado entre os compatíveis em carga de outra rota
+static bool TrySwap(const Data& data, Solution& solution, std::mt19937& rng, double& delta) {
+    if (solution.routes.size() < 2) return false;
+    const long long Q = data.getVehicleCapacity();
+
+    std::vector<size_t> valid_routes;
+    for (size_t i = 0; i < solution.routes.size(); ++i) {
+        if (solution.routes[i].nodes.size() > 2) {
+            valid_routes.push_back(i);
+        }
+    }
+
+    if (valid_routes.size() < 2) return false;
+
+    std::uniform_int_distribution<size_t> valid_dist(0, valid_routes.size() - 1);
+    size_t idx1 = valid_dist(rng);
+    size_t idx2;
+    do {
+        idx2 = valid_dist(rng);
+    } while (idx1 == idx2);
+
+    Route& route1 = solution.routes[valid_routes[idx1]];
+    Route& route2 = solution.routes[valid_routes[idx2]];
+
+    std::uniform_int_distribution<size_t> pos1_dist(1, route1.nodes.size() - 2);
+    size_t pos1 = pos1_dist(rng);
+    long long d1 = NodeDemand(data, route1.nodes[pos1]);
+
+    RouteLoadProfile profile1, profile2;
+    BuildLoadProfile(data, route1, profile1);
+    BuildLoadProfile(data, route2, profile2);
+    std::vector<size_t> partners;
+    for (size_t pos2 = 1; pos2 + 1 < route2.nodes.size(); ++pos2) {
+        long long delta = NodeDemand(data, route2.nodes[pos2]) - d1;
+        if (CanReplaceAt(profile1, pos1, delta, Q) && CanReplaceAt(profile2, pos2, -delta, Q)) {
+            partners.push_back(pos2);
+        }
+    }
+    if (partners.empty()) return false;
+
+    std::uniform_int_distribution<size_t> partner_dist(0, partners.size() - 1);
+    size_t pos2 = partners[partner_dist(rng)];
+    const std::vector<int>& n1 = route1.nodes;
+    const std::vector<int>& n2 = route2.nodes;
+    delta = data.getTravelCost(n1[pos1 - 1], n2[pos2]) + data.getTravelCost(n2[pos2], n1[pos1 + 1]) -
+            data.getTravelCost(n1[pos1 - 1], n1[pos1]) - data.getTravelCost(n1[pos1], n1[pos1 + 1]) +
+            data.getTravelCost(n2[pos2 - 1], n1[pos1]) + data.getTravelCost(n1[pos1], n2[pos2 + 1]) -
+            data.getTravelCost(n2[pos2 - 1], n2[pos2]) - data.getTravelCost(n2[pos2], n2[pos2 + 1]);
+    std::swap(route1.nodes[pos1], route2.nodes[pos2]);
+    return true;
+}
+
+// Inverte um trecho curto (até strength + 1 estações) de uma rota, se a inversão for viável
+static bool TryReverse(const Data& data, Solution& solution, std::mt19937& rng, int strength, double& delta) {
+    std::uniform_int_distribution<size_t> route_dist(0, solution.routes.size() - 1);
+    Route& route = solution.routes[route_dist(rng)];
+
+    if (route.nodes.size() < 5) return false; // Need at least 0-a-b-c-0
+
+    std::uniform_int_distribution<size_t> pos_dist(1, route.nodes.size() - 3);
+    size_t pos1 = pos_dist(rng);
+    size_t pos2 = pos1 + 1 + (rng() % std::min(strength, static_cast<int>(route.nodes.size() - pos1 - 2)));
+
+    if (pos2 >= route.nodes.size() - 1) return false;
+
+    RouteLoadProfile profile;
+    BuildLoadProfile(data, route, profile);
+    if (!CanReverseSegment(profile, pos1, pos2, data.getVehicleCapacity())) return false;
+
+    const std::vector<int>& n = route.nodes;
+    delta = data.getTravelCost(n[pos1 - 1], n[pos2]) + data.getTravelCost(n[pos1], n[pos2 + 1]) -
+            data.getTravelCost(n[pos1 - 1], n[pos1]) - data.getTravelCost(n[pos2], n[pos2 + 1]);
+    for (size_t t = pos1; t < pos2; ++t) {
+        delta += data.getTravelCost(n[t + 1], n[t]) - data.getTravelCost(n[t], n[t + 1]);
+    }
+
+    std::reverse(route.nodes.begin() + pos1, route.nodes.begin() + pos2 + 1);
+    return true;
+}
+
+const char* ApplyRandomPerturbation(const Data& data, Solution& solution,
+                                    std::mt19937& rng, int strength, double* predicted) {
+    if (solution.routes.empty()) return nullptr;
     
+    static const char* const kStrategyNames[] = {"block-relocate", "swap", "reverse"};
+
     std::uniform_int_distribution<int> strategy_dist(0, 2);
-    int strategy = strategy_dist(rng);
-    
-    switch (strategy) {
-        case 0: {
-            if (solution.routes.size() < 2) return;
-            
-            std::uniform_int_distribution<size_t> route_dist(0, solution.routes.size() - 1);
-            size_t from_route_idx, to_route_idx;
-            do {
-                from_route_idx = route_dist(rng);
-                to_route_idx = route_dist(rng);
-            } while (from_route_idx == to_route_idx);
-            
-            Route& from_route = solution.routes[from_route_idx];
-            Route& to_route = solution.routes[to_route_idx];
-            
-            if (from_route.nodes.size() <= 2) return;
-            
-            int available_stations = static_cast<int>(from_route.nodes.size()) - 2;
-            int block_size = std::min(strength, std::max(1, available_stations / 2));
-            std::uniform_int_distribution<int> size_dist(1, std::min(block_size, available_stations));
-            int selected_size = size_dist(rng);
-            
-            std::uniform_int_distribution<size_t> start_dist(1, from_route.nodes.size() - 1 - selected_size);
-            size_t start_pos = start_dist(rng);
-            
-            std::vector<int> block(from_route.nodes.begin() + start_pos,
-                                  from_route.nodes.begin() + start_pos + selected_size);
-            std::vector<int> original_from_nodes = from_route.nodes;
-            from_route.nodes.erase(from_route.nodes.begin() + start_pos,
-                                  from_route.nodes.begin() + start_pos + selected_size);
-
-            if (!CheckRouteFeasible(data, from_route).ok) {
-                from_route.nodes = std::move(original_from_nodes);
-                break;
-            }
-            
-            bool inserted = false;
-            for (size_t pos = 1; pos <= to_route.nodes.size() - 1 && !inserted; ++pos) {
-                Route test_route = to_route;
-                test_route.nodes.insert(test_route.nodes.begin() + pos, block.begin(), block.end());
-                
-                RouteFeasInfo feas_info = CheckRouteFeasible(data, test_route);
-                if (feas_info.ok) {
-                    to_route = test_route;
-                    inserted = true;
-                }
-            }
-            
-            if (!inserted) {
-                from_route.nodes = std::move(original_from_nodes);
+    for (int attempt = 0; attempt < kPerturbAttempts; ++attempt) {
+        int strategy = strategy_dist(rng);
+        bool applied = false;
+        double delta = 0.0;
+        switch (strategy) {
+            case 0: applied = TryBlockRelocate(data, solution, rng, strength, delta); break;
+            case 1: applied = TrySwap(data, solution, rng, delta); break;
+            case 2: applied = TryReverse(data, solution, rng, strength, delta); break;
+        }
+        if (applied) {
+            if (predicted) *predicted = delta;
+            solution.total_cost = SolutionCost(data, solution);
+            return kStrategyNames[strategy];
+        }
+    }
+    return nullptr;
+}
+
+namespace {
+
+// Nova melhor solução encontrada dentro de um reinício
+struct ImprovementEvent {
+    long long iter;   // busca local (contada a partir do início do reinício) que a produziu
+    std::string op;
+    double cost;
+};
+
+// Resultado de um reinício: melhor solução (partindo do incumbente recebido) e melhorias
+struct RestartOutcome {
+    Solution best;
+    Solution local_optimum;  // construção + RVND, candidata ao conjunto elite
+    double alpha = 0.0;
+    long long searches = 0;
+    long long perturbations = 0;
+    long long effective_perturbations = 0;  // alteraram a solução (as demais não chamam o RVND)
+    AdaptivePenalty penalty;                // λ da busca penalizada (entra e sai atualizado)
+    long long penalized_feasible = 0;       // ótimos locais penalizados já viáveis
+    long long repairs_failed = 0;
+    AllocCounts allocations;                // alocações do reinício (só com JPBIKE_ALLOC_STATS)
+    int restart = 0;                        // índice t do reinício (reprodutor do --verify)
+    std::vector<ImprovementEvent> events;
+};
+
+// Busca local de uma execução do ILS: o RVND especializado para o pipeline escolhido (o
+// despacho indireto fica em uma chamada por busca, não por passo)
+struct SearchSetup {
+    std::function<Solution(const Data&, const Solution&, std::mt19937&, RVNDStats*)> rvnd;
+};
+
+// Um reinício do ILS: GRASP (ou warm start) + RVND e o laço de perturbação. O laço parte do
+// incumbente `best` — no modo sequencial é a melhor solução global; no paralelo, a melhor
+// solução do início da rodada. on_event é chamado a cada melhora de `best`.
+void RunRestart(const Data& data, std::mt19937& rng, const ILSParams& p, const SearchSetup& search,
+                const Solution* start, const std::function<bool()>& out_of_time, RestartOutcome& out,
+                const std::function<void(const RestartOutcome&)>& on_event) {
+    const AllocCounts alloc_start = ThreadAllocCounts();
+    out.alpha = SampleAlpha(rng, p.alpha_min, p.alpha_max);
+
+    Solution current_solution;
+    {
+        PhaseTimer timer(p.trace, "construction");
+        current_solution = start ? *start : BuildInitial_GRASP(data, rng, out.alpha, p.grasp_threads);
+    }
+
+    SetVerifyContext(out.restart, out.searches + 1);
+    RVNDStats rvnd_stats;
+    {
+        PhaseTimer timer(p.trace, "rvnd");
+        current_solution = search.rvnd(data, current_solution, rng, &rvnd_stats);
+    }
+    out.searches++;
+
+    // Com frota curta o GRASP pode deixar estações de fora: a solução parece mais barata, mas não
+    // serve de incumbente nem de elite
+    const bool complete = CheckSolutionFeasible(data, current_solution.routes);
+    if (complete) {
+        out.local_optimum = current_solution;
+    }
+
+    if (complete && current_solution.total_cost < out.best.total_cost) {
+        out.best = current_solution;
+        out.events.push_back({out.searches, OperatorLabel(start ? "warm-start" : "grasp", rvnd_stats),
+                              out.best.total_cost});
+        on_event(out);
+    }
+
+    int stall = 0;
+    Solution current_best = out.best;
+
+    while (stall < p.max_iter_ils && !out_of_time()) {
+        SetVerifyContext(out.restart, out.searches + 1);
+        Solution perturbed_solution = current_best;
+        const char* strategy;
+        const bool verify = VerifyNextMove();
+        double predicted = 0.0;
+        {
+            PhaseTimer timer(p.trace, "perturbation");
+            strategy = ApplyRandomPerturbation(data, perturbed_solution, rng, p.perturb_strength, &predicted);
+        }
+        if (strategy && verify) {
+            VerifyMove(data, perturbed_solution, strategy, current_best.total_cost, predicted);
+        }
+        out.perturbations++;
+        if (!strategy) {
+            // Nenhum movimento viável sorteado: a solução não mudou e o RVND seria desperdiçado
+            stall++;
+            continue;
+        }
+        out.effective_perturbations++;
+
+        RVNDStats perturbed_stats;
+        if (p.penalized) {
+            {
+                PhaseTimer timer(p.trace, "rvnd");
+                perturbed_solution = PenalizedRVND(data, perturbed_solution, out.penalty.lambda, rng, &perturbed_stats);
             }
-            break;
-        }
-        
-        case 1: {
-            if (solution.routes.size() < 2) return;
-            
-            std::vector<size_t> valid_routes;
-            for (size_t i = 0; i < solution.routes.size(); ++i) {
-                if (solution.routes[i].nodes.size() > 2) {
-                    valid_routes.push_back(i);
+            out.searches++;
+            bool feasible = SolutionViolation(data, perturbed_solution) == 0;
+            out.penalty.record(feasible);
+            if (feasible) {
+                out.penalized_feasible++;
+            } else {
+                PhaseTimer timer(p.trace, "repair");
+                if (!ProjectToFeasible(data, perturbed_solution, rng, &perturbed_stats)) {
+                    out.repairs_failed++;
+                    stall++;
+                    continue;
                 }
             }
-            
-            if (valid_routes.size() < 2) return;
-            
-            std::uniform_int_distribution<size_t> valid_dist(0, valid_routes.size() - 1);
-            size_t idx1 = valid_dist(rng);
-            size_t idx2;
-            do {
-                idx2 = valid_dist(rng);
-            } while (idx1 == idx2);
-            
-            Route& route1 = solution.routes[valid_routes[idx1]];
-            Route& route2 = solution.routes[valid_routes[idx2]];
-            
-            std::uniform_int_distribution<size_t> pos1_dist(1, route1.nodes.size() - 2);
-            std::uniform_int_distribution<size_t> pos2_dist(1, route2.nodes.size() - 2);
-            
-            size_t pos1 = pos1_dist(rng);
-            size_t pos2 = pos2_dist(rng);
-            
-            int station1 = route1.nodes[pos1];
-            int station2 = route2.nodes[pos2];
-            
-            route1.nodes[pos1] = station2;
-            route2.nodes[pos2] = station1;
-            
-            bool route1_feasible = CheckRouteFeasible(data, route1).ok;
-            bool route2_feasible = CheckRouteFeasible(data, route2).ok;
-            
-            if (!route1_feasible || !route2_feasible) {
-                route1.nodes[pos1] = station1;
-                route2.nodes[pos2] = station2;
-            }
-            break;
-        }
-        
-        case 2: {
-            if (solution.routes.empty()) return;
-            
-            std::uniform_int_distribution<size_t> route_dist(0, solution.routes.size() - 1);
-            size_t route_idx = route_dist(rng);
-            Route& route = solution.routes[route_idx];
-            
-            if (route.nodes.size() < 5) return; // Need at least 0-a-b-c-0
-            
-            std::uniform_int_distribution<size_t> pos_dist(1, route.nodes.size() - 3);
-            size_t pos1 = pos_dist(rng);
-            size_t pos2 = pos1 + 1 + (rng() % std::min(strength, static_cast<int>(route.nodes.size() - pos1 - 2)));
-            
-            if (pos2 >= route.nodes.size() - 1) return;
-            
-            std::reverse(route.nodes.begin() + pos1, route.nodes.begin() + pos2 + 1);
-            
-            RouteFeasInfo feas_info = CheckRouteFeasible(data, route);
-            if (!feas_info.ok) {
-                std::reverse(route.nodes.begin() + pos1, route.nodes.begin() + pos2 + 1);
+        } else {
+            PhaseTimer timer(p.trace, "rvnd");
+            perturbed_solution = search.rvnd(data, perturbed_solution, rng, &perturbed_stats);
+            out.searches++;
+        }
+
+        if (perturbed_solution.total_cost < current_best.total_cost) {
+            current_best = perturbed_solution;
+            stall = 0;
+
+            if (current_best.total_cost < out.best.total_cost && CheckSolutionFeasible(data, current_best.routes)) {
+                out.best = current_best;
+                std::string source = std::string("perturb:") + strategy;
+                out.events.push_back({out.searches, OperatorLabel(source, perturbed_stats), out.best.total_cost});
+                on_event(out);
             }
-            break;
+        } else {
+            stall++;
         }
     }
-    
-    solution.total_cost = SolutionCost(data, solution);
+    out.allocations = ThreadAllocCounts() - alloc_start;
 }
 
-Solution ILS(const Data& data, std::mt19937& rng, const ILSParams& p, bool verbose) {
+} // namespace
+
+Solution ILS(const Data& data, std::mt19937& rng, const ILSParams& p, bool verbose,
+             const Solution* initial) {
     Solution best_solution;
     best_solution.total_cost = std::numeric_limits<double>::infinity();
+
+    // λ corrente da busca penalizada: passa de um reinício ao seguinte (no modo paralelo,
+    // todos os reinícios de uma rodada partem do mesmo λ e vale o do último na ordem de t)
+    AdaptivePenalty penalty;
+    if (p.penalized) {
+        penalty.lambda = InitialPenalty(data);
+        penalty.target = p.penalty_target;
+    }
     
     if (verbose) {
         std::cout << "\n=== ILS (Iterated Local Search) ===" << std::endl;
@@ -151,53 +357,308 @@ Solution ILS(const Data& data, std::mt19937& rng, const ILSParams& p, bool verbo
                   << ", max_iter_ils=" << p.max_iter_ils
                   << ", alpha=[" << p.alpha_min << "," << p.alpha_max << "]"
                   << ", perturb_strength=" << p.perturb_strength << std::endl;
+        if (p.threads > 0) {
+            std::cout << "Modo determinístico: threads=" << p.threads << ", batch=" << p.batch << std::endl;
+        }
+        if (p.penalized) {
+            std::cout << "Busca penalizada: alvo de " << p.penalty_target << " ótimos locais viáveis, λ inicial = "
+                      << penalty.lambda << std::endl;
+        }
+        if (p.elite_size > 0) {
+            std::cout << "Conjunto elite: " << p.elite_size << " soluções, path relinking a cada "
+                      << p.relink_every << " iterações (" << p.relink_pairs << " pares)" << std::endl;
+        }
     }
     
-    for (int t = 1; t <= p.max_iter; ++t) {
-        double alpha = SampleAlpha(rng, p.alpha_min, p.alpha_max);
-        
-        Solution current_solution = BuildInitial_GRASP(data, rng, alpha);
-        
-        current_solution = RVND(data, current_solution, rng);
-        
-        if (current_solution.total_cost < best_solution.total_cost) {
-            best_solution = current_solution;
-            if (verbose) {
-                std::cout << "Iter " << t << ": Nova melhor solução = " << best_solution.total_cost << std::endl;
+    // Cache de rotas sem melhora intra-rota e memo do re-sequenciamento exato, compartilhados
+    // por todos os RVND da execução. O cache não muda o resultado, só poupa varreduras
+    RouteOptimaCache route_cache(size_t{1} << 22, std::max(1, p.or_opt_max));
+    SequenceMemo memo;
+    const CachedPipeline cached_pipeline(RelocateNeighborhood{}, SwapNeighborhood{},
+                                         CachedTwoOptNeighborhood{route_cache}, CachedOrOpt2Neighborhood{route_cache});
+    const CachedOrOptPipeline or_opt_pipeline(RelocateNeighborhood{}, SwapNeighborhood{},
+                                              CachedTwoOptNeighborhood{route_cache}, CachedOrOptNeighborhood{route_cache});
+    const ResequencePipeline resequence_pipeline(RelocateNeighborhood{}, SwapNeighborhood{},
+                                                 ResequenceNeighborhood{memo, &route_cache});
+    SearchSetup search;
+    if (p.resequence) {
+        search.rvnd = [&resequence_pipeline](const Data& d, const Solution& s, std::mt19937& r, RVNDStats* st) {
+            return RVNDWith(d, s, r, resequence_pipeline, st);
+        };
+    } else if (p.or_opt_max > 0) {
+        search.rvnd = [&or_opt_pipeline](const Data& d, const Solution& s, std::mt19937& r, RVNDStats* st) {
+            return RVNDWith(d, s, r, or_opt_pipeline, st);
+        };
+    } else {
+        search.rvnd = [&cached_pipeline](const Data& d, const Solution& s, std::mt19937& r, RVNDStats* st) {
+            return RVNDWith(d, s, r, cached_pipeline, st);
+        };
+    }
+
+    long long iter = 0;  // buscas locais executadas (reinícios + perturbações)
+    long long perturbations = 0;
+    long long effective_perturbations = 0;
+    long long penalized_feasible = 0;
+    long long repairs_failed = 0;
+    auto start_time = std::chrono::steady_clock::now();
+    std::function<bool()> out_of_time = [&]() {
+        if (p.cancel && p.cancel->load(std::memory_order_relaxed)) return true;
+        if (p.time_limit <= 0.0) return false;
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_time;
+        return elapsed.count() >= p.time_limit;
+    };
+
+    // Registra uma melhoria do incumbente global (iter já convertido para a contagem global)
+    auto report = [&](int t, double alpha, const ImprovementEvent& event) {
+        if (verbose) {
+            std::cout << "Iter " << t << (event.iter > 1 ? " (ILS)" : "") << ": Nova melhor solução = "
+                      << event.cost << "\n";
+        }
+        if (p.trace) {
+            p.trace->improvement(iter + event.iter, t, alpha, event.op, event.cost);
+        }
+    };
+
+    // Alocações de uma iteração e pico de RSS (só compilado com JPBIKE_ALLOC_STATS)
+    auto report_iteration = [&](int t, const AllocCounts& allocated) {
+        if (!kAllocStatsEnabled) return;
+        long peak_rss = ReadProcStatusKb("VmHWM");
+        if (verbose) {
+            std::cout << "Iter " << t << ": " << allocated.allocations << " alocações, " << allocated.bytes
+                      << " bytes, pico de RSS " << peak_rss << " kB\n";
+        }
+        if (p.trace) {
+            p.trace->iteration(t, allocated, peak_rss);
+        }
+    };
+
+    // Com warm start nenhum reinício constrói do zero: o primeiro parte de `initial` e os
+    // seguintes do incumbente que recebem, e só o laço de perturbação + RVND diversifica.
+    // Re-otimizar custa assim uma fração de uma execução a frio, que paga um GRASP por reinício.
+    auto warm_start = [initial](const Solution& incumbent) -> const Solution* {
+        if (!initial) return nullptr;
+        return incumbent.routes.empty() ? initial : &incumbent;
+    };
+
+    // Conjunto elite e path relinking: a iteração t múltipla de relink_every, com pelo menos
+    // duas elites, troca o reinício GRASP por caminhos das melhores elites até a melhor
+    std::unique_ptr<ElitePool> elite;
+    if (p.elite_size > 0) {
+        elite = std::make_unique<ElitePool>(data, p.elite_size);
+    }
+    auto relink_slot = [&](int t) { return elite && p.relink_every > 0 && t % p.relink_every == 0; };
+    const int relink_threads = p.threads > 0 ? p.threads
+                                             : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+    // Pares processados em paralelo, cada um com seu fluxo de phase_seed; redução na ordem dos pares
+    auto relink_round = [&](int t, uint64_t phase_seed) {
+        const Solution guiding = (*elite)[0];
+        int pairs = std::min(p.relink_pairs, elite->size() - 1);
+        std::vector<Solution> initials;
+        for (int k = 1; k <= pairs; ++k) {
+            initials.push_back((*elite)[k]);
+        }
+
+        std::vector<Solution> results(static_cast<size_t>(pairs));
+        std::vector<RVNDStats> stats(static_cast<size_t>(pairs));
+        std::vector<AllocCounts> allocations(static_cast<size_t>(pairs));
+        ParallelFor(pairs, relink_threads, [&](int k) {
+            AllocCounts before = ThreadAllocCounts();
+            SetVerifyContext(t, 0);
+            {
+                PhaseTimer timer(p.trace, "relink");
+                std::mt19937 pair_rng = MakeStreamRng(phase_seed, static_cast<uint64_t>(k));
+                results[k] = PathRelink(data, initials[k], guiding, pair_rng, kRelinkSearchPoints, &stats[k]);
+            }
+            allocations[k] = ThreadAllocCounts() - before;
+        });
+
+        for (int k = 0; k < pairs; ++k) {
+            elite->add(results[k]);
+            if (results[k].total_cost < best_solution.total_cost &&
+                CheckSolutionFeasible(data, results[k].routes)) {
+                best_solution = results[k];
+                report(t, 0.0, {k + 1, OperatorLabel("relink", stats[k]), best_solution.total_cost});
+                if (p.on_improvement) p.on_improvement(best_solution);
             }
         }
-        
-        int stall = 0;
-        Solution current_best = best_solution;
-        
-        while (stall < p.max_iter_ils) {
-            Solution perturbed_solution = current_best;
-            ApplyRandomPerturbation(data, perturbed_solution, rng, p.perturb_strength);
-            
-                perturbed_solution = RVND(data, perturbed_solution, rng);
-            
-            if (perturbed_solution.total_cost < current_best.total_cost) {
-                current_best = perturbed_solution;
-                stall = 0;
-                
-                if (current_best.total_cost < best_solution.total_cost) {
-                    best_solution = current_best;
-                    if (verbose) {
-                        std::cout << "Iter " << t << " (ILS): Nova melhor solução = " << best_solution.total_cost << std::endl;
-                    }
+        iter += pairs;
+        if (verbose) {
+            std::cout << "Iter " << t << " (path relinking): " << pairs << " pares, elite = " << elite->size()
+                      << std::endl;
+        }
+        AllocCounts round_allocations;
+        for (const AllocCounts& allocated : allocations) {
+            round_allocations += allocated;
+        }
+        report_iteration(t, round_allocations);
+    };
+
+    auto absorb_into_elite = [&](const RestartOutcome& outcome) {
+        if (elite) {
+            elite->add(outcome.local_optimum);
+            elite->add(outcome.best);
+        }
+    };
+
+    if (p.threads <= 0) {
+        // Fluxo único: todas as iterações consomem o mesmo rng, em ordem
+        for (int t = 1; t <= p.max_iter; ++t) {
+            if (t > 1 && out_of_time()) {
+                if (verbose) {
+                    std::cout << "Limite de tempo atingido após " << (t - 1) << " iterações" << std::endl;
                 }
+                break;
+            }
+
+            if (relink_slot(t) && elite->size() >= 2) {
+                uint64_t phase_seed = (static_cast<uint64_t>(rng()) << 32) | rng();
+                relink_round(t, phase_seed);
             } else {
-                stall++;
+                RestartOutcome outcome;
+                outcome.best = best_solution;
+                outcome.penalty = penalty;
+                outcome.restart = t;
+                RunRestart(data, rng, p, search, warm_start(outcome.best), out_of_time, outcome,
+                           [&](const RestartOutcome& o) {
+                               report(t, o.alpha, o.events.back());
+                               if (p.on_improvement) p.on_improvement(o.best);
+                           });
+                absorb_into_elite(outcome);
+                best_solution = std::move(outcome.best);
+                iter += outcome.searches;
+                perturbations += outcome.perturbations;
+                effective_perturbations += outcome.effective_perturbations;
+                penalized_feasible += outcome.penalized_feasible;
+                repairs_failed += outcome.repairs_failed;
+                penalty = outcome.penalty;
+                report_iteration(t, outcome.allocations);
+            }
+
+            if (verbose && t % 10 == 0) {
+                std::cout << "Progresso: " << t << "/" << p.max_iter << " iterações completadas" << std::endl;
             }
         }
-        
-        if (verbose && t % 10 == 0) {
-            std::cout << "Progresso: " << t << "/" << p.max_iter << " iterações completadas" << std::endl;
+    } else {
+        // Modo determinístico: o reinício t usa o fluxo t da semente base e as rodadas têm
+        // `batch` reinícios que partem do mesmo incumbente; a redução segue a ordem de t.
+        // O resultado depende só da semente e de batch, não do número de threads.
+        const uint64_t base_seed = (static_cast<uint64_t>(rng()) << 32) | rng();
+        const int batch = std::max(1, p.batch);
+        bool stopped = false;
+
+        auto absorb = [&](int t, RestartOutcome& outcome) {
+            for (const ImprovementEvent& event : outcome.events) {
+                if (event.cost < best_solution.total_cost) {
+                    report(t, outcome.alpha, event);
+                }
+            }
+            absorb_into_elite(outcome);
+            if (outcome.best.total_cost < best_solution.total_cost) {
+                best_solution = std::move(outcome.best);
+                if (p.on_improvement) p.on_improvement(best_solution);
+            }
+            iter += outcome.searches;
+            perturbations += outcome.perturbations;
+            effective_perturbations += outcome.effective_perturbations;
+            penalized_feasible += outcome.penalized_feasible;
+            repairs_failed += outcome.repairs_failed;
+            penalty = outcome.penalty;
+            report_iteration(t, outcome.allocations);
+        };
+
+        for (int first = 1; first <= p.max_iter && !stopped; first += batch) {
+            if (first > 1 && out_of_time()) {
+                if (verbose) {
+                    std::cout << "Limite de tempo atingido após " << (first - 1) << " iterações" << std::endl;
+                }
+                break;
+            }
+
+            int count = std::min(batch, p.max_iter - first + 1);
+            std::vector<RestartOutcome> outcomes(static_cast<size_t>(count));
+            std::vector<char> ran(static_cast<size_t>(count), 0);
+
+            // Posições de relinking ficam para depois da redução da rodada
+            ParallelFor(count, p.threads, [&](int k) {
+                int t = first + k;
+                if ((t > 1 && out_of_time()) || relink_slot(t)) {
+                    return;
+                }
+                std::mt19937 task_rng = MakeStreamRng(base_seed, static_cast<uint64_t>(t));
+                RestartOutcome& outcome = outcomes[static_cast<size_t>(k)];
+                outcome.best = best_solution;
+                outcome.penalty = penalty;
+                outcome.restart = t;
+                RunRestart(data, task_rng, p, search, warm_start(outcome.best), out_of_time, outcome,
+                           [](const RestartOutcome&) {});
+                ran[static_cast<size_t>(k)] = 1;
+            });
+
+            for (int k = 0; k < count; ++k) {
+                int t = first + k;
+                if (relink_slot(t) && !(t > 1 && out_of_time())) {
+                    if (elite->size() >= 2) {
+                        relink_round(t, StreamSeed(base_seed, static_cast<uint64_t>(t)));
+                    } else {
+                        std::mt19937 task_rng = MakeStreamRng(base_seed, static_cast<uint64_t>(t));
+                        RestartOutcome& outcome = outcomes[static_cast<size_t>(k)];
+                        outcome.best = best_solution;
+                        outcome.penalty = penalty;
+                        outcome.restart = t;
+                        RunRestart(data, task_rng, p, search, warm_start(outcome.best), out_of_time, outcome,
+                                   [](const RestartOutcome&) {});
+                        absorb(t, outcome);
+                    }
+                } else if (!ran[static_cast<size_t>(k)]) {
+                    stopped = true;
+                    continue;
+                } else {
+                    absorb(t, outcomes[static_cast<size_t>(k)]);
+                }
+
+                if (verbose && t % 10 == 0) {
+                    std::cout << "Progresso: " << t << "/" << p.max_iter << " iterações completadas" << std::endl;
+                }
+            }
         }
     }
     
     if (verbose) {
         std::cout << "ILS finalizado. Melhor custo: " << best_solution.total_cost << std::endl;
+        std::cout << "Perturbações efetivas: " << effective_perturbations << "/" << perturbations << std::endl;
+        long long route_lookups = route_cache.hits() + route_cache.misses();
+        std::cout << "Cache intra-rota: " << route_cache.hits() << "/" << route_lookups << " rotas sem varredura ("
+                  << (route_lookups > 0
+                          ? 100.0 * static_cast<double>(route_cache.hits()) / static_cast<double>(route_lookups)
+                          : 0.0)
+                  << "%)" << std::endl;
+        if (p.resequence) {
+            long long lookups = memo.hits() + memo.misses();
+            std::cout << "Re-sequenciamento exato: " << memo.hits() << "/" << lookups << " consultas no memo ("
+                      << (lookups > 0 ? 100.0 * static_cast<double>(memo.hits()) / static_cast<double>(lookups) : 0.0)
+                      << "%)" << std::endl;
+        }
+        if (p.penalized) {
+            std::cout << "Busca penalizada: " << penalized_feasible << "/" << effective_perturbations
+                      << " ótimos locais viáveis, " << repairs_failed << " reparos sem sucesso, λ final = "
+                      << penalty.lambda << std::endl;
+        }
+    }
+    if (p.trace) {
+        p.trace->addCounter("perturbations", static_cast<double>(perturbations));
+        p.trace->addCounter("perturbations_effective", static_cast<double>(effective_perturbations));
+        p.trace->addCounter("route_cache_hits", static_cast<double>(route_cache.hits()));
+        p.trace->addCounter("route_cache_misses", static_cast<double>(route_cache.misses()));
+        if (p.resequence) {
+            p.trace->addCounter("resequence_hits", static_cast<double>(memo.hits()));
+            p.trace->addCounter("resequence_misses", static_cast<double>(memo.misses()));
+        }
+        if (p.penalized) {
+            p.trace->addCounter("penalized_feasible", static_cast<double>(penalized_feasible));
+            p.trace->addCounter("repairs_failed", static_cast<double>(repairs_failed));
+            p.trace->addCounter("penalty_final", penalty.lambda);
+        }
     }
     
     return best_solution;
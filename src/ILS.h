@@ -1,10 +1,13 @@
 #ifndef ILS_H
 #define ILS_H
 
+#include <atomic>
+#include <functional>
 #include <random>
 #include "Instance.h"
 #include "Construction.h"   // Solution type
 #include "LocalSearch.h"    // RVND steps
+#include "Trace.h"
 
 struct ILSParams {
     int     max_iter        = 50;
@@ -12,9 +15,62 @@ struct ILSParams {
     double  alpha_min       = 0.1;
     double  alpha_max       = 0.5;
     int     perturb_strength= 2;
+    double  time_limit      = 0.0;  // segundos; 0 = sem limite
+
+    // 0 = fluxo único de números aleatórios (comportamento original). >= 1 = modo
+    // determinístico: cada reinício tem seu próprio fluxo, rodadas de `batch` reinícios
+    // executam em `threads` threads e o resultado não depende do número de threads
+    // (exceto quando time_limit interrompe a busca)
+    int     threads         = 0;
+    int     batch           = 8;
+
+    // Threads da avaliação de candidatos dentro de cada construção GRASP (1 = sequencial); a
+    // construção não depende desse número
+    int     grasp_threads   = 1;
+
+    // Conjunto elite (0 = desligado) e path relinking no lugar de um reinício GRASP a cada
+    // relink_every iterações, das relink_pairs melhores elites até a melhor
+    int     elite_size      = 0;
+    int     relink_every    = 5;
+    int     relink_pairs    = 3;
+
+    // Busca penalizada: as buscas locais após perturbação aceitam violar a capacidade, com
+    // custo + λ·violação e λ ajustado para manter penalty_target de ótimos locais viáveis;
+    // ótimos inviáveis são reparados antes de competir com o incumbente
+    bool    penalized       = false;
+    double  penalty_target  = 0.5;
+
+    // RVND com re-sequenciamento exato das rotas curtas (memoizado durante a execução) no
+    // lugar de 2-opt e Or-opt-2
+    bool    resequence      = false;
+
+    // RVND com Or-opt de trechos de 1 a or_opt_max estações, nas duas orientações, no lugar
+    // do Or-opt-2 (0 = Or-opt-2)
+    int     or_opt_max      = 0;
+
+    // Chamada a cada nova melhor solução global (streaming de progresso)
+    std::function<void(const Solution&)> on_improvement;
+
+    // Cancelamento cooperativo: quando vira true a busca para como no fim do time_limit (entre
+    // buscas locais) e devolve a melhor solução até ali
+    const std::atomic<bool>* cancel = nullptr;
+
+    // Registro de convergência e tempos por fase (opcional)
+    TraceSink* trace = nullptr;
 };
 
+// Perturba a solução com um movimento viável sorteado (bloco para outra rota, troca entre
+// rotas ou inversão curta). Blocos, parceiros de troca e trechos invertidos são filtrados
+// pelos perfis de carga, com poucas tentativas. Retorna o nome da estratégia aplicada, ou
+// nullptr se nenhuma tentativa achou movimento viável (solução inalterada). Com `predicted`,
+// recebe a variação de custo calculada pelos arcos trocados (para --verify).
+const char* ApplyRandomPerturbation(const Data& data, Solution& solution,
+                                    std::mt19937& rng, int strength, double* predicted = nullptr);
+
+// Com `initial` (warm start) nenhum reinício usa o GRASP: o primeiro parte dessa solução e
+// os seguintes do melhor incumbente até ali
 [[nodiscard]] Solution ILS(const Data& data, std::mt19937& rng,
-                           const ILSParams& p, bool verbose);
+                           const ILSParams& p, bool verbose,
+                           const Solution* initial = nullptr);
 
 #endif
@@ -1,4 +1,10 @@
 #include "Instance.h"
+#include "SharedInstance.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <limits>
 
 using namespace std;
 
@@ -22,26 +28,131 @@ Data::Data(int argc, char *argv[]) :
     n_stations = -1;
 }
 
-Data::~Data() {
-    if (cost_matrix != nullptr) {
-        for (int i = 0; i <= n_stations; i++) {
-            delete[] cost_matrix[i];
+Data::Data(const string& path) :
+    instance_name(path), nb_of_par(2), n_stations(-1), cost_matrix(nullptr) {}
+
+Data::Data(const string& name, int n, int m, int Q, const vector<long long>& demands, const vector<double>& costs) :
+    instance_name(name), nb_of_par(0), n_stations(n), m_vehicles(m), vehicle_capacity(Q),
+    station_demands(demands), cost_matrix(nullptr) {
+
+    int matrix_size = n_stations + 1;
+    if (static_cast<int>(station_demands.size()) != n_stations ||
+        costs.size() != static_cast<size_t>(matrix_size) * matrix_size) {
+        cerr << "Erro: dimensões inconsistentes para a instância " << name << endl;
+        exit(1);
+    }
+
+    allocateCostMatrix();
+    for (int i = 0; i < matrix_size; i++) {
+        copy(costs.begin() + static_cast<size_t>(i) * matrix_size,
+             costs.begin() + static_cast<size_t>(i + 1) * matrix_size, cost_matrix[i]);
+    }
+}
+
+Data::Data(const string& name, int n, int m, int Q, const long long* demands, const double* costs) :
+    instance_name(name), nb_of_par(0), n_stations(n), m_vehicles(m), vehicle_capacity(Q),
+    station_demands(demands, demands + n), cost_matrix(nullptr) {
+    // Só os ponteiros de linha são alocados; nenhum caminho de escrita da matriz (read,
+    // memória compartilhada) é usado num Data construído assim
+    setMatrixRows(const_cast<double*>(costs));
+}
+
+Data::~Data() = default;
+
+void Data::setMatrixRows(double* block) {
+    size_t matrix_size = static_cast<size_t>(n_stations) + 1;
+    matrix_rows.resize(matrix_size);
+    for (size_t i = 0; i < matrix_size; i++) {
+        matrix_rows[i] = block + i * matrix_size;
+    }
+    cost_matrix = matrix_rows.data();
+}
+
+void Data::allocateCostMatrix() {
+    size_t matrix_size = static_cast<size_t>(n_stations) + 1;
+    if (shared && shared_creator) {
+        if (shared->allocate(n_stations, m_vehicles, vehicle_capacity)) {
+            setMatrixRows(shared->matrix());
+            return;
         }
-        delete[] cost_matrix;
+        cerr << "Aviso: não foi possível dimensionar a memória compartilhada; matriz em memória privada" << endl;
+        shared.reset();
+    }
+    owned_matrix.assign(matrix_size * matrix_size, 0.0);
+    setMatrixRows(owned_matrix.data());
+}
+
+bool Data::attachShared() {
+    string name = SharedInstance::SegmentName(instance_name);
+    if (name.empty()) {
+        return false;  // read() acusa o arquivo inexistente
+    }
+    bool created = false;
+    shared = SharedInstance::open(name, created);
+    if (!shared) {
+        cerr << "Aviso: memória compartilhada indisponível para " << instance_name << "; lendo em memória privada"
+             << endl;
+        return false;
+    }
+    shared_creator = created;
+    if (created) {
+        return false;  // read() preenche o segmento e publishShared() o libera
+    }
+
+    n_stations = shared->stations();
+    m_vehicles = shared->vehicles();
+    vehicle_capacity = shared->capacity();
+    station_demands.assign(shared->demands(), shared->demands() + n_stations);
+    setMatrixRows(shared->matrix());
+    return true;
+}
+
+void Data::publishShared() {
+    if (shared && shared_creator) {
+        copy(station_demands.begin(), station_demands.end(), shared->demands());
+        shared->publish();
     }
 }
 
 void Data::read() {
-    ifstream inFile(instance_name, ios::in);
+    string error;
+    if (!tryRead(error)) {
+        cerr << "Erro: " << error << endl;
+        exit(1);
+    }
+}
+
+bool Data::tryRead(string& error) {
+    if (share_matrix && attachShared()) {
+        return true;
+    }
+
+    ifstream inFile(instance_name, ios::in | ios::binary);
     
     if (!inFile) {
-        cerr << "Erro: arquivo não encontrado: " << instance_name << endl;
-        exit(1);
+        error = "arquivo não encontrado: " + instance_name;
+        return false;
+    }
+
+    char magic[sizeof(kBinaryMagic)] = {};
+    inFile.read(magic, sizeof(magic));
+    if (inFile.gcount() == sizeof(magic) && memcmp(magic, kBinaryMagic, sizeof(magic)) == 0) {
+        if (!readBinary(inFile, error)) {
+            return false;
+        }
+        publishShared();
+        return true;
     }
+    inFile.clear();
+    inFile.seekg(0);
     
     inFile >> n_stations;
     inFile >> m_vehicles;
     inFile >> vehicle_capacity;
+    if (!inFile || !validHeader()) {
+        error = "cabeçalho inválido (n, m e Q devem ser positivos): " + instance_name;
+        return false;
+    }
     
     string empty_line;
     getline(inFile, empty_line);
@@ -56,26 +167,124 @@ void Data::read() {
     }
     
     if (static_cast<int>(station_demands.size()) != n_stations) {
-        cerr << "Erro: número de demandas (" << station_demands.size()
-             << ") não confere com número de estações (" << n_stations << ")" << endl;
-        exit(1);
+        error = "número de demandas (" + to_string(station_demands.size()) +
+                ") não confere com número de estações (" + to_string(n_stations) + "): " + instance_name;
+        return false;
     }
     
     getline(inFile, empty_line);
     
     int matrix_size = n_stations + 1;
-    cost_matrix = new double*[matrix_size];
-    for (int i = 0; i < matrix_size; i++) {
-        cost_matrix[i] = new double[matrix_size];
-    }
+    allocateCostMatrix();
 
     for (int i = 0; i < matrix_size; i++) {
         for (int j = 0; j < matrix_size; j++) {
             inFile >> cost_matrix[i][j];
         }
     }
+    if (!inFile) {
+        error = "matriz de custos incompleta ou inválida: " + instance_name;
+        return false;
+    }
     
     inFile.close();
+    publishShared();
+    return true;
+}
+
+bool Data::validHeader() const {
+    return n_stations > 0 && m_vehicles > 0 && vehicle_capacity > 0;
+}
+
+bool Data::readBinary(ifstream& inFile, string& error) {
+    int32_t header[3] = {0, 0, 0};
+    inFile.read(reinterpret_cast<char*>(header), sizeof(header));
+    n_stations = header[0];
+    m_vehicles = header[1];
+    vehicle_capacity = header[2];
+
+    if (!inFile || !validHeader()) {
+        error = "cabeçalho binário inválido: " + instance_name;
+        return false;
+    }
+
+    // O tamanho do arquivo tem de bater com o cabeçalho antes de alocar demandas e matriz: um
+    // n corrompido pediria (n+1)² doubles. cells <= payload / 8 / cells evita estouro no produto.
+    const streamoff data_start = inFile.tellg();
+    inFile.seekg(0, ios::end);
+    const streamoff file_end = inFile.tellg();
+    inFile.seekg(data_start);
+    const uint64_t payload = file_end > data_start ? static_cast<uint64_t>(file_end - data_start) : 0;
+    const uint64_t cells = static_cast<uint64_t>(n_stations) + 1;
+    if (cells > payload / sizeof(double) / cells ||
+        payload != static_cast<uint64_t>(n_stations) * sizeof(int64_t) + cells * cells * sizeof(double)) {
+        error = "tamanho do arquivo binário não confere com o cabeçalho (n = " + to_string(n_stations) +
+                "): " + instance_name;
+        return false;
+    }
+
+    vector<int64_t> demands(n_stations);
+    inFile.read(reinterpret_cast<char*>(demands.data()), static_cast<streamsize>(demands.size() * sizeof(int64_t)));
+    station_demands.assign(demands.begin(), demands.end());
+
+    int matrix_size = n_stations + 1;
+    allocateCostMatrix();
+    for (int i = 0; i < matrix_size; i++) {
+        inFile.read(reinterpret_cast<char*>(cost_matrix[i]), static_cast<streamsize>(matrix_size * sizeof(double)));
+    }
+
+    if (!inFile) {
+        error = "arquivo binário truncado: " + instance_name;
+        return false;
+    }
+    return true;
+}
+
+bool Data::writeText(const string& path) const {
+    ofstream outFile(path);
+    if (!outFile) {
+        cerr << "Erro: não foi possível criar arquivo: " << path << endl;
+        return false;
+    }
+
+    outFile << n_stations << "\n" << m_vehicles << "\n" << vehicle_capacity << "\n\n";
+    for (int i = 0; i < n_stations; i++) {
+        outFile << station_demands[i] << (i + 1 < n_stations ? " " : "");
+    }
+    outFile << "\n\n";
+
+    outFile << setprecision(numeric_limits<double>::max_digits10);
+    int matrix_size = n_stations + 1;
+    for (int i = 0; i < matrix_size; i++) {
+        for (int j = 0; j < matrix_size; j++) {
+            outFile << cost_matrix[i][j] << (j + 1 < matrix_size ? " " : "");
+        }
+        outFile << "\n";
+    }
+
+    return static_cast<bool>(outFile);
+}
+
+bool Data::writeBinary(const string& path) const {
+    ofstream outFile(path, ios::out | ios::binary);
+    if (!outFile) {
+        cerr << "Erro: não foi possível criar arquivo: " << path << endl;
+        return false;
+    }
+
+    int32_t header[3] = {n_stations, m_vehicles, vehicle_capacity};
+    outFile.write(kBinaryMagic, sizeof(kBinaryMagic));
+    outFile.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+    vector<int64_t> demands(station_demands.begin(), station_demands.end());
+    outFile.write(reinterpret_cast<const char*>(demands.data()), static_cast<streamsize>(demands.size() * sizeof(int64_t)));
+
+    int matrix_size = n_stations + 1;
+    for (int i = 0; i < matrix_size; i++) {
+        outFile.write(reinterpret_cast<const char*>(cost_matrix[i]), static_cast<streamsize>(matrix_size * sizeof(double)));
+    }
+
+    return static_cast<bool>(outFile);
 }
 
 void Data::printDistanceMatrix() {
@@ -110,6 +319,100 @@ void Data::printJPBikeInstanceData() {
     }
 }
 
+const vector<int>& Data::getNeighbors(int i) const {
+    call_once(neighbors_once, [this] { buildNeighborLists(); });
+    return neighbor_lists[i];
+}
+
+void Data::buildNeighborLists() const {
+    const int matrix_size = n_stations + 1;
+
+    neighbor_lists.assign(matrix_size, {});
+    vector<int> heap;
+    heap.reserve(kNeighborListSize);
+
+    for (int i = 0; i < matrix_size; i++) {
+        const double *row = cost_matrix[i];
+        auto closer = [row](int a, int b) { return row[a] < row[b] || (row[a] == row[b] && a < b); };
+
+        // Max-heap dos k mais próximos vistos até agora: uma única passada pela linha, e como
+        // j cresce, um empate com o topo nunca o substitui
+        heap.clear();
+        for (int j = 1; j <= n_stations; j++) {
+            if (j == i) {
+                continue;
+            }
+            if (static_cast<int>(heap.size()) < kNeighborListSize) {
+                heap.push_back(j);
+                push_heap(heap.begin(), heap.end(), closer);
+            } else if (row[j] < row[heap.front()]) {
+                pop_heap(heap.begin(), heap.end(), closer);
+                heap.back() = j;
+                push_heap(heap.begin(), heap.end(), closer);
+            }
+        }
+
+        sort_heap(heap.begin(), heap.end(), closer);
+        neighbor_lists[i] = heap;
+    }
+}
+
+void Data::renumber(const vector<int>& order) {
+    const int matrix_size = n_stations + 1;
+    if (static_cast<int>(order.size()) != n_stations) {
+        cout << "Erro: renumeração com " << order.size() << " estações; esperado " << n_stations << endl;
+        exit(1);
+    }
+
+    // old_of[i] = id atual da estação que passa a ser i
+    vector<int> old_of(matrix_size, 0);
+    vector<char> seen(matrix_size, 0);
+    for (int i = 1; i <= n_stations; i++) {
+        int v = order[i - 1];
+        if (v < 1 || v > n_stations || seen[v]) {
+            cout << "Erro: renumeração inválida (estação " << v << ")" << endl;
+            exit(1);
+        }
+        seen[v] = 1;
+        old_of[i] = v;
+    }
+
+    // A matriz permutada é sempre privada: um segmento compartilhado é solto
+    vector<double> permuted(static_cast<size_t>(matrix_size) * matrix_size);
+    for (int i = 0; i < matrix_size; i++) {
+        const double *row = cost_matrix[old_of[i]];
+        double *out = permuted.data() + static_cast<size_t>(i) * matrix_size;
+        for (int j = 0; j < matrix_size; j++) {
+            out[j] = row[old_of[j]];
+        }
+    }
+    owned_matrix.swap(permuted);
+    setMatrixRows(owned_matrix.data());
+    shared.reset();
+
+    vector<long long> demands(n_stations);
+    for (int i = 1; i <= n_stations; i++) {
+        demands[i - 1] = station_demands[old_of[i] - 1];
+    }
+    station_demands.swap(demands);
+
+    // Compõe com uma renumeração anterior, se houver
+    vector<int> original(matrix_size);
+    for (int i = 0; i < matrix_size; i++) {
+        original[i] = getOriginalId(old_of[i]);
+    }
+    original_ids.swap(original);
+    internal_ids.assign(matrix_size, 0);
+    for (int i = 0; i < matrix_size; i++) {
+        internal_ids[original_ids[i]] = i;
+    }
+
+    // getNeighbors já pode ter sido chamado: a lista antiga não vale para os novos ids
+    if (!neighbor_lists.empty()) {
+        buildNeighborLists();
+    }
+}
+
 string Data::getInstanceName() const {
     string::size_type loc = instance_name.find_last_of(".", instance_name.size());
     string::size_type loc2 = instance_name.find_last_of("/", instance_name.size());
@@ -119,7 +422,7 @@ string Data::getInstanceName() const {
     if (loc != string::npos) {
         instance.append(instance_name, loc2 + 1, loc - loc2 - 1);
     } else {
-        instance.append(instance_name, loc2 + 1, instance.size());
+        instance.append(instance_name, loc2 + 1, string::npos);
     }
     
     return instance;
@@ -6,14 +6,37 @@
 #include <fstream>
 #include <sstream>
 #include <vector>
+#include <memory>
+#include <mutex>
 #include <math.h>
 
+class SharedInstance;
+
 class Data {
 public:
     Data(int argc, char *argv[]);
+    explicit Data(const std::string& path);
+    // Instância já em memória (benchmarks, instâncias sintéticas); costs em ordem de linha, (n+1) x (n+1)
+    Data(const std::string& name, int n, int m, int Q, const std::vector<long long>& demands,
+         const std::vector<double>& costs);
+    // Matriz do chamador, sem cópia: costs aponta para (n+1) x (n+1) doubles em ordem de linha e
+    // precisa viver mais que o Data. Nunca é escrita (renumber passa a usar uma cópia privada).
+    Data(const std::string& name, int n, int m, int Q, const long long* demands, const double* costs);
     ~Data();
 
+    // read() encerra o processo com "Erro: ..." se o arquivo for inválido; tryRead() devolve a
+    // mensagem em error (daemon, biblioteca) e deixa o Data inutilizável em caso de falha
     void read();
+    bool tryRead(std::string& error);
+    // Com true antes de read(), demandas e matriz ficam num segmento de memória compartilhada
+    // nomeado pelo arquivo (SharedInstance.h): outros processos com a mesma instância anexam o
+    // segmento em vez de ler o arquivo. Sem suporte a shm, read() lê em memória privada.
+    void useSharedMemory(bool enable) { share_matrix = enable; }
+    [[nodiscard]] bool isShared() const noexcept { return shared != nullptr; }
+    [[nodiscard]] bool attachedShared() const noexcept { return shared != nullptr && !shared_creator; }
+    // Escrita no formato texto do JP-Bike ou no formato binário (lido de volta por read())
+    bool writeText(const std::string& path) const;
+    bool writeBinary(const std::string& path) const;
     void printDistanceMatrix();
     void printJPBikeInstanceData();
     
@@ -22,8 +45,28 @@ public:
     [[nodiscard]] inline int getVehicleCapacity() const noexcept { return vehicle_capacity; }
     [[nodiscard]] inline double getTravelCost(int i, int j) const { return cost_matrix[i][j]; }
     [[nodiscard]] inline double **getCostMatrix() { return cost_matrix; }
+    // A matriz inteira, contígua em ordem de linha ((n+1) x (n+1))
+    [[nodiscard]] inline const double *getCostData() const { return cost_matrix[0]; }
     [[nodiscard]] inline long long getStationDemand(int i) const { return i < station_demands.size() ? station_demands[i] : 0; }
     [[nodiscard]] inline std::vector<long long> getAllDemands() const { return station_demands; }
+
+    // Lista dos vizinhos mais próximos de i (estações 1..n, exclui i), ordenada por (c(i,j), j).
+    // Construída sob demanda uma única vez e limitada a kNeighborListSize entradas: qualquer
+    // estação fora da lista é estritamente pior que a última da lista nessa ordem.
+    [[nodiscard]] const std::vector<int>& getNeighbors(int i) const;
+
+    static constexpr int kNeighborListSize = 64;
+
+    // Renumera as estações: a nova estação i (1..n) é a antiga order[i-1]; o depósito continua 0.
+    // Permuta fisicamente matriz e demandas (e refaz as listas de vizinhos, se já existiam).
+    // Os ids do arquivo de entrada continuam acessíveis por getOriginalId/getInternalId.
+    void renumber(const std::vector<int>& order);
+    [[nodiscard]] bool isRenumbered() const noexcept { return !original_ids.empty(); }
+    [[nodiscard]] inline int getOriginalId(int v) const { return original_ids.empty() ? v : original_ids[v]; }
+    [[nodiscard]] inline int getInternalId(int v) const { return internal_ids.empty() ? v : internal_ids[v]; }
+
+    // Formato binário: magic, n, m, Q (int32), demandas (int64 x n), matriz (double, linha a linha)
+    static constexpr char kBinaryMagic[8] = {'J', 'P', 'B', 'I', 'K', 'E', 'B', '1'};
     
     [[nodiscard]] std::string getInstanceName() const;
 
@@ -36,7 +79,28 @@ private:
     int vehicle_capacity = 0;
     
     std::vector<long long> station_demands;
-    double **cost_matrix;
+    double **cost_matrix;  // ponteiros de linha para a matriz contígua (privada ou compartilhada)
+
+    std::vector<double>  owned_matrix;
+    std::vector<double*> matrix_rows;
+    bool share_matrix = false;
+    bool shared_creator = false;
+    std::unique_ptr<SharedInstance> shared;
+
+    // Vazios enquanto a numeração é a do arquivo
+    std::vector<int> original_ids;
+    std::vector<int> internal_ids;
+
+    mutable std::once_flag neighbors_once;
+    mutable std::vector<std::vector<int>> neighbor_lists;
+
+    void buildNeighborLists() const;
+    bool readBinary(std::ifstream& inFile, std::string& error);
+    bool validHeader() const;
+    void allocateCostMatrix();
+    void setMatrixRows(double* block);
+    bool attachShared();
+    void publishShared();
 };
 
 #endif
@@ -0,0 +1,186 @@
+#include "JPBike.h"
+#include "Solver.h"
+#include <atomic>
+#include <cstdlib>
+#include <exception>
+#include <new>
+#include <string>
+#include <vector>
+
+struct jpbike_cancel_token {
+    std::atomic<bool> cancelled{false};
+};
+
+struct jpbike_result {
+    Solution solution;
+    bool feasible = false;
+    bool cancelled = false;
+};
+
+namespace {
+
+thread_local std::string last_error;
+
+jpbike_result* Fail(const std::string& message) {
+    last_error = message;
+    return nullptr;
+}
+
+// Mesmas faixas aceitas pela linha de comando; vazio se as opções são válidas
+std::string CheckOptions(const jpbike_options& o) {
+    if (o.constructive < 0 || o.constructive > 2) return "constructive deve ser 0, 1 ou 2";
+    if (o.max_iter <= 0 || o.max_iter_ils <= 0 || o.perturb_strength <= 0) return "iterações do ILS devem ser > 0";
+    if (o.alpha_min < 0.0 || o.alpha_max > 1.0 || o.alpha_min > o.alpha_max) return "alpha fora de [0, 1]";
+    if (o.time_limit < 0.0 || o.threads < 0 || o.batch <= 0 || o.grasp_threads <= 0) return "paralelismo inválido";
+    if (o.elite_size < 0 || o.relink_every <= 0 || o.relink_pairs <= 0) return "parâmetros do conjunto elite inválidos";
+    if (o.penalty_target <= 0.0 || o.penalty_target >= 1.0) return "penalty_target deve estar em (0, 1)";
+    if (o.or_opt_max < 0 || o.decompose_size <= 0) return "or_opt_max/decompose_size inválidos";
+    if (o.decompose && !o.use_ils) return "decompose exige use_ils";
+    return "";
+}
+
+} // namespace
+
+extern "C" {
+
+void jpbike_default_options(jpbike_options* options) {
+    const SolverOptions defaults;
+    const ILSParams& ils = defaults.ils;
+    *options = jpbike_options{};
+    options->seed = defaults.seed;
+    options->use_ils = defaults.use_ils ? 1 : 0;
+    options->constructive = 0;
+    options->use_vnd = defaults.use_vnd ? 1 : 0;
+    options->max_iter = ils.max_iter;
+    options->max_iter_ils = ils.max_iter_ils;
+    options->alpha_min = ils.alpha_min;
+    options->alpha_max = ils.alpha_max;
+    options->perturb_strength = ils.perturb_strength;
+    options->time_limit = ils.time_limit;
+    options->threads = ils.threads;
+    options->batch = ils.batch;
+    options->grasp_threads = ils.grasp_threads;
+    options->elite_size = ils.elite_size;
+    options->relink_every = ils.relink_every;
+    options->relink_pairs = ils.relink_pairs;
+    options->penalized = ils.penalized ? 1 : 0;
+    options->penalty_target = ils.penalty_target;
+    options->resequence = ils.resequence ? 1 : 0;
+    options->or_opt_max = ils.or_opt_max;
+    options->decompose = defaults.decompose ? 1 : 0;
+    options->decompose_size = defaults.decompose_size;
+    options->renumber = defaults.renumber ? 1 : 0;
+    options->aggregate_threshold = -1.0;
+}
+
+jpbike_cancel_token* jpbike_cancel_token_create(void) {
+    return new (std::nothrow) jpbike_cancel_token;
+}
+
+void jpbike_cancel(jpbike_cancel_token* token) {
+    token->cancelled.store(true);
+}
+
+void jpbike_cancel_token_destroy(jpbike_cancel_token* token) {
+    delete token;
+}
+
+jpbike_result* jpbike_solve(int n, int m, int Q, const long long* demands, const double* costs,
+                            const jpbike_options* options, jpbike_progress_fn progress, void* user_data,
+                            const jpbike_cancel_token* cancel) {
+    if (n <= 0 || m <= 0 || Q <= 0 || !demands || !costs) {
+        return Fail("instância inválida: n, m e Q devem ser > 0 e demands/costs não nulos");
+    }
+    for (int i = 0; i < n; ++i) {
+        if (std::llabs(demands[i]) > Q) {
+            return Fail("demanda da estação " + std::to_string(i + 1) + " excede a capacidade");
+        }
+    }
+    jpbike_options o;
+    jpbike_default_options(&o);
+    if (options) {
+        o = *options;
+    }
+    std::string error = CheckOptions(o);
+    if (!error.empty()) {
+        return Fail(error);
+    }
+
+    try {
+        Data data("memory", n, m, Q, demands, costs);
+
+        static const char* const kConstructive[] = {"nearest", "insertion", "savings"};
+        SolverOptions so;
+        so.seed = o.seed;
+        so.use_ils = o.use_ils != 0;
+        so.constructive = kConstructive[o.constructive];
+        so.use_vnd = o.use_vnd != 0;
+        so.decompose = o.decompose != 0;
+        so.decompose_size = o.decompose_size;
+        so.renumber = o.renumber != 0;
+        so.aggregate = o.aggregate_threshold >= 0.0;
+        so.aggregate_threshold = o.aggregate_threshold;
+        so.ils.max_iter = o.max_iter;
+        so.ils.max_iter_ils = o.max_iter_ils;
+        so.ils.alpha_min = o.alpha_min;
+        so.ils.alpha_max = o.alpha_max;
+        so.ils.perturb_strength = o.perturb_strength;
+        so.ils.time_limit = o.time_limit;
+        so.ils.threads = o.threads;
+        so.ils.batch = o.batch;
+        so.ils.grasp_threads = o.grasp_threads;
+        so.ils.elite_size = o.elite_size;
+        so.ils.relink_every = o.relink_every;
+        so.ils.relink_pairs = o.relink_pairs;
+        so.ils.penalized = o.penalized != 0;
+        so.ils.penalty_target = o.penalty_target;
+        so.ils.resequence = o.resequence != 0;
+        so.ils.or_opt_max = o.or_opt_max;
+        so.ils.cancel = cancel ? &cancel->cancelled : nullptr;
+        if (progress) {
+            so.on_progress = [progress, user_data](double cost, double seconds) { progress(cost, seconds, user_data); };
+        }
+
+        SolveResult solved = Solve(data, so, false);
+        auto* result = new jpbike_result;
+        result->solution = std::move(solved.solution);
+        result->feasible = solved.feasible;
+        result->cancelled = solved.cancelled;
+        last_error = solved.warning;
+        return result;
+    } catch (const std::exception& e) {
+        return Fail(e.what());
+    }
+}
+
+const char* jpbike_last_error(void) {
+    return last_error.c_str();
+}
+
+double jpbike_result_cost(const jpbike_result* result) {
+    return result->solution.total_cost;
+}
+
+int jpbike_result_feasible(const jpbike_result* result) {
+    return result->feasible ? 1 : 0;
+}
+
+int jpbike_result_cancelled(const jpbike_result* result) {
+    return result->cancelled ? 1 : 0;
+}
+
+size_t jpbike_result_num_routes(const jpbike_result* result) {
+    return result->solution.routes.size();
+}
+
+size_t jpbike_result_route(const jpbike_result* result, size_t r, const int** nodes) {
+    const std::vector<int>& route = result->solution.routes[r].nodes;
+    *nodes = route.data();
+    return route.size();
+}
+
+void jpbike_result_free(jpbike_result* result) {
+    delete result;
+}
+
+} // extern "C"
@@ -0,0 +1,92 @@
+/* API C da biblioteca libjpbike (lib/libjpbike.a, lib/libjpbike.so): resolve uma instância
+ * já em memória, sem arquivo de instância nem processo separado. A matriz de custos é do
+ * chamador e é lida no lugar (sem cópia) durante jpbike_solve; as demandas são copiadas.
+ *
+ *   jpbike_options options;
+ *   jpbike_default_options(&options);
+ *   options.use_ils = 1;
+ *   jpbike_result* result = jpbike_solve(n, m, Q, demands, costs, &options, NULL, NULL, NULL);
+ *   for (size_t r = 0; r < jpbike_result_num_routes(result); ++r) {
+ *       const int* nodes;
+ *       size_t size = jpbike_result_route(result, r, &nodes);  // 0, estações..., 0
+ *   }
+ *   jpbike_result_free(result);
+ *
+ * Ids: depósito 0, estações 1..n na ordem de `demands`. A biblioteca não escreve em
+ * stdout/stderr: progresso vai para o callback e avisos para jpbike_last_error.
+ */
+#ifndef JPBIKE_H
+#define JPBIKE_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct jpbike_options {
+    unsigned int seed;
+    int    use_ils;           /* 1 = ILS; 0 = construtivo (+ VND) */
+    int    constructive;      /* 0 = nearest, 1 = insertion, 2 = savings (também o início da decomposição) */
+    int    use_vnd;           /* VND após o construtivo (sem ILS) */
+    int    max_iter;
+    int    max_iter_ils;
+    double alpha_min;
+    double alpha_max;
+    int    perturb_strength;
+    double time_limit;        /* segundos; 0 = sem limite */
+    int    threads;           /* 0 = fluxo aleatório único; >= 1 = modo determinístico */
+    int    batch;
+    int    grasp_threads;
+    int    elite_size;
+    int    relink_every;
+    int    relink_pairs;
+    int    penalized;
+    double penalty_target;
+    int    resequence;
+    int    or_opt_max;        /* 0 = Or-opt-2 */
+    int    decompose;         /* exige use_ils */
+    int    decompose_size;
+    int    renumber;
+    double aggregate_threshold;  /* < 0 = sem agregação */
+} jpbike_options;
+
+/* Os padrões do executável */
+void jpbike_default_options(jpbike_options* options);
+
+/* Chamada a cada nova melhor solução, na thread que a encontrou */
+typedef void (*jpbike_progress_fn)(double cost, double seconds, void* user_data);
+
+/* Cancelamento: jpbike_cancel (de qualquer thread) faz jpbike_solve devolver a melhor solução
+ * encontrada até ali, na próxima verificação entre buscas locais */
+typedef struct jpbike_cancel_token jpbike_cancel_token;
+jpbike_cancel_token* jpbike_cancel_token_create(void);
+void                 jpbike_cancel(jpbike_cancel_token* token);
+void                 jpbike_cancel_token_destroy(jpbike_cancel_token* token);
+
+typedef struct jpbike_result jpbike_result;
+
+/* demands: n demandas (estações 1..n); costs: (n+1) x (n+1) em ordem de linha, depósito na
+ * linha/coluna 0, válido até o retorno. options, progress e cancel podem ser NULL. Devolve NULL
+ * se a entrada for inválida ou faltar memória (jpbike_last_error descreve o motivo). */
+jpbike_result* jpbike_solve(int n, int m, int Q, const long long* demands, const double* costs,
+                            const jpbike_options* options, jpbike_progress_fn progress, void* user_data,
+                            const jpbike_cancel_token* cancel);
+
+/* Mensagem do último jpbike_solve desta thread que devolveu NULL ou uma solução inviável
+ * (estações sem rota por falta de veículos); vazia se o último foi bem-sucedido */
+const char* jpbike_last_error(void);
+
+double jpbike_result_cost(const jpbike_result* result);
+int    jpbike_result_feasible(const jpbike_result* result);
+int    jpbike_result_cancelled(const jpbike_result* result);
+size_t jpbike_result_num_routes(const jpbike_result* result);
+/* Rota r (0, estações..., 0): *nodes aponta para memória do resultado; devolve o tamanho */
+size_t jpbike_result_route(const jpbike_result* result, size_t r, const int** nodes);
+void   jpbike_result_free(jpbike_result* result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
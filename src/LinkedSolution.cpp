@@ -0,0 +1,315 @@
+#include "LinkedSolution.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <sstream>
+
+LinkedSolution::LinkedSolution(const Data& data, const Solution& solution)
+    : data(data), n(data.getNumStations()) {
+    int num_routes = static_cast<int>(solution.routes.size());
+    int size = n + 1 + num_routes;
+
+    next.assign(size, -1);
+    prev.assign(size, -1);
+    route_of.assign(size, -1);
+    pos.assign(size, 0);
+    routes.assign(num_routes, RouteSummary{});
+    dirty.assign(num_routes, 1);
+
+    for (int r = 0; r < num_routes; ++r) {
+        const std::vector<int>& nodes = solution.routes[r].nodes;
+        int depot = depotOf(r);
+        int last = depot;
+        route_of[depot] = r;
+
+        for (size_t i = 1; i + 1 < nodes.size(); ++i) {
+            int v = nodes[i];
+            link(last, v);
+            route_of[v] = r;
+            routes[r].size++;
+            routes[r].load += demand(v);
+            routes[r].cost += c(last, v);
+            last = v;
+        }
+        link(last, depot);
+        routes[r].cost += c(last, depot);
+        total_cost += routes[r].cost;
+    }
+}
+
+Solution LinkedSolution::toSolution() const {
+    Solution solution;
+    solution.routes.resize(routes.size());
+
+    for (int r = 0; r < numRoutes(); ++r) {
+        std::vector<int>& nodes = solution.routes[r].nodes;
+        nodes.reserve(routes[r].size + 2);
+        nodes.push_back(0);
+        for (int v = next[depotOf(r)]; v != depotOf(r); v = next[v]) {
+            nodes.push_back(v);
+        }
+        nodes.push_back(0);
+    }
+
+    solution.total_cost = SolutionCost(data, solution);
+    return solution;
+}
+
+int LinkedSolution::position(int v) const {
+    int r = route_of[v];
+    if (dirty[r]) {
+        refresh(r);
+    }
+    return pos[v];
+}
+
+const LinkedSolution::RouteSummary& LinkedSolution::summary(int r) const {
+    if (dirty[r]) {
+        refresh(r);
+    }
+    return routes[r];
+}
+
+bool LinkedSolution::routeFeasible(int r) const {
+    const RouteSummary& s = summary(r);
+    long long Q = data.getVehicleCapacity();
+    return std::max(0LL, -s.min_prefix) <= Q - s.max_prefix;
+}
+
+void LinkedSolution::refresh(int r) const {
+    RouteSummary& s = routes[r];
+    long long prefix = 0;
+    s.max_prefix = 0;
+    s.min_prefix = 0;
+
+    int k = 0;
+    for (int v = next[depotOf(r)]; v != depotOf(r); v = next[v]) {
+        pos[v] = ++k;
+        prefix += demand(v);
+        s.max_prefix = std::max(s.max_prefix, prefix);
+        s.min_prefix = std::min(s.min_prefix, prefix);
+    }
+    dirty[r] = 0;
+}
+
+void LinkedSolution::relocate(int v, int after) {
+    if (after == v || after == prev[v]) {
+        return;
+    }
+
+    // Remove v de entre a e b
+    int a = prev[v];
+    int b = next[v];
+    int from = route_of[v];
+    addRouteCost(from, c(a, b) - c(a, v) - c(v, b));
+    link(a, b);
+    routes[from].size--;
+    routes[from].load -= demand(v);
+    dirty[from] = 1;
+
+    // Insere entre after e seu sucessor
+    int d = next[after];
+    int to = route_of[after];
+    addRouteCost(to, c(after, v) + c(v, d) - c(after, d));
+    link(after, v);
+    link(v, d);
+    route_of[v] = to;
+    routes[to].size++;
+    routes[to].load += demand(v);
+    dirty[to] = 1;
+}
+
+void LinkedSolution::swap(int u, int v) {
+    if (u == v) {
+        return;
+    }
+    // Vizinhos imediatos: trocar equivale a mover um para depois do outro
+    if (next[u] == v) {
+        relocate(u, v);
+        return;
+    }
+    if (next[v] == u) {
+        relocate(v, u);
+        return;
+    }
+
+    int au = prev[u], bu = next[u];
+    int av = prev[v], bv = next[v];
+    int ru = route_of[u], rv = route_of[v];
+
+    addRouteCost(ru, c(au, v) + c(v, bu) - c(au, u) - c(u, bu));
+    addRouteCost(rv, c(av, u) + c(u, bv) - c(av, v) - c(v, bv));
+
+    link(au, v);
+    link(v, bu);
+    link(av, u);
+    link(u, bv);
+
+    std::swap(route_of[u], route_of[v]);
+    long long delta = demand(v) - demand(u);
+    routes[ru].load += delta;
+    routes[rv].load -= delta;
+    dirty[ru] = 1;
+    dirty[rv] = 1;
+}
+
+void LinkedSolution::reverse(int first, int last) {
+    if (first == last) {
+        return;
+    }
+
+    int a = prev[first];
+    int b = next[last];
+    int r = route_of[first];
+
+    // Inverte os ponteiros internos acumulando a variação de custo (matriz pode ser assimétrica)
+    double delta = c(a, last) + c(first, b) - c(a, first) - c(last, b);
+    for (int x = first;;) {
+        assert(!isDepot(x) && "reverse: last não vem depois de first na mesma rota");
+        int y = next[x];
+        std::swap(next[x], prev[x]);
+        if (x == last) {
+            break;
+        }
+        delta += c(y, x) - c(x, y);
+        x = y;
+    }
+
+    link(a, last);
+    link(first, b);
+    addRouteCost(r, delta);
+    dirty[r] = 1;
+}
+
+void LinkedSolution::moveSegment(int first, int last, int after, bool reversed) {
+    int a = prev[first];
+    int b = next[last];
+    int from = route_of[first];
+
+    if (after == a && !reversed) {
+        return;
+    }
+
+    // Desliga o segmento, somando custo interno (nos dois sentidos) e carga
+    double inner = 0.0;
+    double inner_reversed = 0.0;
+    long long load = 0;
+    int count = 0;
+    for (int x = first;; x = next[x]) {
+        // Um sentinela no caminho quer dizer last fora da rota de first ou antes dele; after
+        // dentro do trecho deixaria o segmento religado a si mesmo
+        assert(!isDepot(x) && "moveSegment: last não vem depois de first na mesma rota");
+        assert(x != after && "moveSegment: after dentro do trecho");
+        load += demand(x);
+        count++;
+        if (x == last) {
+            break;
+        }
+        inner += c(x, next[x]);
+        inner_reversed += c(next[x], x);
+    }
+
+    addRouteCost(from, c(a, b) - c(a, first) - inner - c(last, b));
+    link(a, b);
+    routes[from].size -= count;
+    routes[from].load -= load;
+    dirty[from] = 1;
+
+    int head = first;
+    int tail = last;
+    if (reversed) {
+        for (int x = first;;) {
+            int y = next[x];
+            std::swap(next[x], prev[x]);
+            if (x == last) {
+                break;
+            }
+            x = y;
+        }
+        head = last;
+        tail = first;
+        inner = inner_reversed;
+    }
+
+    int d = next[after];
+    int to = route_of[after];
+    addRouteCost(to, c(after, head) + inner + c(tail, d) - c(after, d));
+    link(after, head);
+    link(tail, d);
+    routes[to].size += count;
+    routes[to].load += load;
+    dirty[to] = 1;
+
+    if (to != from) {
+        for (int x = head;; x = next[x]) {
+            route_of[x] = to;
+            if (x == tail) {
+                break;
+            }
+        }
+    }
+}
+
+int LinkedSolution::addRoute() {
+    int r = numRoutes();
+    int depot = n + 1 + r;
+    next.push_back(depot);
+    prev.push_back(depot);
+    route_of.push_back(r);
+    pos.push_back(0);
+    routes.push_back(RouteSummary{});
+    dirty.push_back(0);
+    return r;
+}
+
+bool LinkedSolution::verify(std::string* error) const {
+    std::ostringstream err;
+    std::vector<char> seen(n + 1, 0);
+    double total = 0.0;
+
+    for (int r = 0; r < numRoutes() && err.str().empty(); ++r) {
+        int depot = depotOf(r);
+        int size = 0;
+        long long load = 0;
+        double cost = 0.0;
+
+        int x = depot;
+        do {
+            int y = next[x];
+            if (y < 0 || y >= static_cast<int>(next.size()) || prev[y] != x) {
+                err << "rota " << r << ": encadeamento quebrado após " << x;
+                break;
+            }
+            cost += c(x, y);
+            if (y != depot) {
+                if (isDepot(y) || seen[y] || route_of[y] != r) {
+                    err << "rota " << r << ": estação " << y << " inválida ou repetida";
+                    break;
+                }
+                seen[y] = 1;
+                size++;
+                load += demand(y);
+            }
+            x = y;
+        } while (x != depot && size <= n);
+
+        if (!err.str().empty()) {
+            break;
+        }
+        const RouteSummary& s = summary(r);
+        if (s.size != size || s.load != load || std::abs(s.cost - cost) > 1e-6 * std::max(1.0, std::abs(cost))) {
+            err << "rota " << r << ": resumo desatualizado (tamanho " << s.size << "/" << size << ", carga "
+                << s.load << "/" << load << ", custo " << s.cost << "/" << cost << ")";
+        }
+        total += cost;
+    }
+
+    if (err.str().empty() && std::abs(total - total_cost) > 1e-6 * std::max(1.0, std::abs(total))) {
+        err << "custo total " << total_cost << " difere do recalculado " << total;
+    }
+
+    if (error) {
+        *error = err.str();
+    }
+    return err.str().empty();
+}
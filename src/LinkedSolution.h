@@ -0,0 +1,85 @@
+#ifndef LINKED_SOLUTION_H
+#define LINKED_SOLUTION_H
+
+#include <string>
+#include <vector>
+#include "Construction.h"
+#include "Instance.h"
+
+// Solução como listas duplamente encadeadas: sucessor, predecessor, rota e posição de cada
+// estação em vetores indexados pelo id. Cada rota r tem um depósito-sentinela próprio, de id
+// n + 1 + r, que fecha o ciclo (succ do sentinela = primeira estação, pred = última), então
+// inserir/remover nunca tem caso especial nas pontas.
+//
+// Custos e carga total das rotas são atualizados em O(1) a cada movimento. Posições e
+// extremos de prefixo de carga (viabilidade) são recalculados sob demanda, em O(tamanho da
+// rota), só para as rotas alteradas desde a última consulta.
+//
+// Por ora é só base: as vizinhanças, perturbações e o Solve continuam sobre Route (vetores)
+// e aplicam os movimentos com insert/erase; só tools/StressMoves e tools/BenchKernels usam
+// esta representação.
+class LinkedSolution {
+public:
+    struct RouteSummary {
+        int       size = 0;        // estações na rota
+        double    cost = 0.0;
+        long long load = 0;        // soma das demandas
+        long long max_prefix = 0;  // extremos de prefixo (incluem 0), válidos após refresh
+        long long min_prefix = 0;
+    };
+
+    LinkedSolution(const Data& data, const Solution& solution);
+
+    [[nodiscard]] Solution toSolution() const;
+
+    [[nodiscard]] int numStations() const { return n; }
+    [[nodiscard]] int numRoutes() const { return static_cast<int>(routes.size()); }
+    [[nodiscard]] int depotOf(int r) const { return n + 1 + r; }
+    [[nodiscard]] bool isDepot(int v) const { return v > n; }
+
+    [[nodiscard]] int succ(int v) const { return next[v]; }
+    [[nodiscard]] int pred(int v) const { return prev[v]; }
+    [[nodiscard]] int routeOf(int v) const { return route_of[v]; }
+    // 1..size para estações, 0 para o sentinela
+    [[nodiscard]] int position(int v) const;
+
+    [[nodiscard]] const RouteSummary& summary(int r) const;
+    [[nodiscard]] bool routeFeasible(int r) const;
+    [[nodiscard]] double totalCost() const { return total_cost; }
+
+    // Movimentos. `after` pode ser uma estação ou um sentinela (início da rota).
+    void relocate(int v, int after);                             // O(1)
+    void swap(int u, int v);                                     // O(1)
+    void reverse(int first, int last);                           // O(segmento); mesma rota, first antes de last
+    // O(segmento). Pré-condições (conferidas com assert ao percorrer o trecho): first..last em
+    // ordem na mesma rota, e after fora do trecho (pode ser de outra rota ou um sentinela).
+    void moveSegment(int first, int last, int after, bool reversed = false);
+    int  addRoute();                                             // nova rota vazia; devolve o id
+
+    // Confere encadeamento, rotas, custos e cargas contra um recálculo completo
+    [[nodiscard]] bool verify(std::string* error = nullptr) const;
+
+private:
+    const Data& data;
+    int n;
+
+    std::vector<int> next;
+    std::vector<int> prev;
+    std::vector<int> route_of;
+    mutable std::vector<int> pos;
+
+    mutable std::vector<RouteSummary> routes;
+    mutable std::vector<char> dirty;  // posições/prefixos desatualizados
+    double total_cost = 0.0;
+
+    // Índice na matriz de custos (sentinelas são o depósito)
+    [[nodiscard]] int loc(int v) const { return v > n ? 0 : v; }
+    [[nodiscard]] double c(int a, int b) const { return data.getTravelCost(loc(a), loc(b)); }
+    [[nodiscard]] long long demand(int v) const { return v > n ? 0 : data.getStationDemand(v - 1); }
+
+    void link(int a, int b) { next[a] = b; prev[b] = a; }
+    void refresh(int r) const;
+    void addRouteCost(int r, double delta) { routes[r].cost += delta; total_cost += delta; }
+};
+
+#endif
@@ -1,31 +1,195 @@
 #include "LocalSearch.h"
 #include "Feasibility.h"
+#include "Rng.h"
+#include "Verify.h"
 #include <algorithm>
-#include <limits>
 
-bool TwoOptStep(const Data& data, Solution& solution, std::mt19937& rng) {
-    for (size_t route_idx = 0; route_idx < solution.routes.size(); ++route_idx) {
-        Route& route = solution.routes[route_idx];
+namespace {
+
+// Melhora mínima aceita: com custos reais, empates por arredondamento não podem gerar ciclos
+constexpr double kMinGain = 1e-7;
+
+// Custos acumulados da rota nos dois sentidos: o trecho nodes[a..b] custa fwd[b] - fwd[a]
+// percorrido em ordem e bwd[b] - bwd[a] invertido. Com o perfil de carga, cada candidato de
+// 2-opt e Or-opt sai em O(1), sem alterar a rota.
+struct IntraRouteProfile {
+    std::vector<double> fwd;
+    std::vector<double> bwd;
+    RouteLoadProfile load;
+};
+
+void BuildIntraRouteProfile(const Data& data, const Route& route, IntraRouteProfile& profile) {
+    const size_t size = route.nodes.size();
+    profile.fwd.resize(size);
+    profile.bwd.resize(size);
+    profile.fwd[0] = profile.bwd[0] = 0.0;
+    for (size_t t = 1; t < size; ++t) {
+        profile.fwd[t] = profile.fwd[t - 1] + data.getTravelCost(route.nodes[t - 1], route.nodes[t]);
+        profile.bwd[t] = profile.bwd[t - 1] + data.getTravelCost(route.nodes[t], route.nodes[t - 1]);
+    }
+    BuildLoadProfile(data, route, profile.load);
+}
+
+// Janelas de carga de partes da rota, relativas à carga no início de cada parte
+RouteLoadWindow HeadWindow(const RouteLoadProfile& load, size_t last) {
+    // nodes[1..last]
+    return {load.prefix[last], load.pre_max[last], load.pre_min[last]};
+}
+
+RouteLoadWindow TailWindow(const RouteLoadProfile& load, size_t first) {
+    // nodes[first..k] (vazio se first == k+1)
+    long long base = load.prefix[first - 1];
+    return {load.prefix.back() - base, std::max(0LL, load.suf_max[first] - base),
+            std::min(0LL, load.suf_min[first] - base)};
+}
+
+// nodes[first..last] invertido, com lo/hi = mínimo/máximo de prefix[first-1..last-1]: após
+// visitar nodes[last..t] a carga relativa é prefix[last] - prefix[t-1]
+RouteLoadWindow ReversedWindow(const RouteLoadProfile& load, size_t first, size_t last, long long lo, long long hi) {
+    long long top = load.prefix[last];
+    return {top - load.prefix[first - 1], std::max(0LL, top - lo), std::min(0LL, top - hi)};
+}
+
+bool Fits(const RouteLoadWindow& a, const RouteLoadWindow& b, const RouteLoadWindow& c, const RouteLoadWindow& d,
+          long long Q) {
+    return WindowFits(ConcatWindows(ConcatWindows(a, b), ConcatWindows(c, d)), Q);
+}
+
+// Trecho nodes[a..a+len-1] (invertido se reversed) reinserido antes da posição b da rota sem ele
+void ApplyOrOptMove(Route& route, const RouteOptimaCache::Move& move) {
+    std::vector<int> chain(route.nodes.begin() + move.a, route.nodes.begin() + move.a + move.len);
+    if (move.reversed) {
+        std::reverse(chain.begin(), chain.end());
+    }
+    route.nodes.erase(route.nodes.begin() + move.a, route.nodes.begin() + move.a + move.len);
+    route.nodes.insert(route.nodes.begin() + move.b, chain.begin(), chain.end());
+}
 
-        if (route.nodes.size() < 4) continue;
+// Primeiro movimento de melhora de cada vizinhança intra-rota; a rota sai com o movimento
+// aplicado e `move` o identifica para RouteOptimaCache
+bool FirstTwoOpt(const Data& data, Route& route, RouteOptimaCache::Move& move) {
+    if (route.nodes.size() < 4) return false;
+
+    const long long Q = static_cast<long long>(data.getVehicleCapacity());
+    const std::vector<int>& n = route.nodes;
+    IntraRouteProfile profile;
+    BuildIntraRouteProfile(data, route, profile);
+    const RouteLoadProfile& load = profile.load;
+    const RouteLoadWindow none{};
+
+    for (size_t i = 1; i < n.size() - 2; ++i) {
+        // Extremos de prefix[i-1..j-1], estendidos a cada j
+        long long lo = load.prefix[i - 1];
+        long long hi = lo;
+        for (size_t j = i + 1; j < n.size() - 1; ++j) {
+            lo = std::min(lo, load.prefix[j - 1]);
+            hi = std::max(hi, load.prefix[j - 1]);
+
+            double delta = data.getTravelCost(n[i - 1], n[j]) + data.getTravelCost(n[i], n[j + 1]) -
+                           data.getTravelCost(n[i - 1], n[i]) - data.getTravelCost(n[j], n[j + 1]) +
+                           (profile.bwd[j] - profile.bwd[i]) - (profile.fwd[j] - profile.fwd[i]);
+            if (delta >= -kMinGain ||
+                !Fits(HeadWindow(load, i - 1), ReversedWindow(load, i, j, lo, hi), TailWindow(load, j + 1), none, Q)) {
+                continue;
+            }
 
-        double original_cost = RouteCost(data, route);
+            std::reverse(route.nodes.begin() + i, route.nodes.begin() + j + 1);
+            move.a = static_cast<int>(i);
+            move.b = static_cast<int>(j);
+            move.delta = delta;
+            return true;
+        }
+    }
 
-        for (size_t i = 1; i < route.nodes.size() - 2; ++i) {
-            for (size_t j = i + 1; j < route.nodes.size() - 1; ++j) {
-                std::reverse(route.nodes.begin() + i, route.nodes.begin() + j + 1);
+    return false;
+}
 
-                RouteFeasInfo feas_info = CheckRouteFeasible(data, route);
-                if (feas_info.ok) {
-                    double new_cost = RouteCost(data, route);
+// Or-opt intra-rota: trechos de min_len a max_len estações reinseridos em outra posição da
+// mesma rota, na ordem original e (com reverse) invertidos. Ordem de varredura: início do
+// trecho, tamanho, posição de destino, orientação.
+bool FirstOrOpt(const Data& data, Route& route, int min_len, int max_len, bool reverse,
+                RouteOptimaCache::Move& move) {
+    const long long Q = static_cast<long long>(data.getVehicleCapacity());
+    const std::vector<int>& n = route.nodes;
+    const size_t k = n.size() - 2;
+    if (k < static_cast<size_t>(min_len) + 1) return false;
+
+    IntraRouteProfile profile;
+    BuildIntraRouteProfile(data, route, profile);
+    const RouteLoadProfile& load = profile.load;
+    std::vector<long long> before_max(k + 1), before_min(k + 1);
+
+    for (size_t s = 1; s + min_len - 1 <= k; ++s) {
+        // Extremos de prefix[q+1..s-1] para cada destino q < s-1 (trecho entre o destino e s)
+        if (s >= 2) {
+            before_max[s - 2] = before_min[s - 2] = load.prefix[s - 1];
+            for (size_t q = s - 2; q-- > 0;) {
+                before_max[q] = std::max(before_max[q + 1], load.prefix[q + 1]);
+                before_min[q] = std::min(before_min[q + 1], load.prefix[q + 1]);
+            }
+        }
 
-                    if (new_cost < original_cost) {
-                        solution.total_cost = SolutionCost(data, solution);
-                        return true;
+        const long long base = load.prefix[s - 1];
+        long long chain_hi = base, chain_lo = base;  // extremos de prefix[s..e]
+        long long rev_hi = base, rev_lo = base;      // extremos de prefix[s-1..e-1]
+        for (size_t e = s; e <= k; ++e) {
+            const int len = static_cast<int>(e - s + 1);
+            chain_hi = std::max(chain_hi, load.prefix[e]);
+            chain_lo = std::min(chain_lo, load.prefix[e]);
+            rev_hi = std::max(rev_hi, load.prefix[e - 1]);
+            rev_lo = std::min(rev_lo, load.prefix[e - 1]);
+            if (len > max_len || (e == k && s == 1)) break;
+            if (len < min_len) continue;
+
+            const RouteLoadWindow forward{load.prefix[e] - base, chain_hi - base, chain_lo - base};
+            const RouteLoadWindow reversed = ReversedWindow(load, s, e, rev_lo, rev_hi);
+            const double removal = data.getTravelCost(n[s - 1], n[e + 1]) - data.getTravelCost(n[s - 1], n[s]) -
+                                   data.getTravelCost(n[e], n[e + 1]);
+            const double reversal = (profile.bwd[e] - profile.bwd[s]) - (profile.fwd[e] - profile.fwd[s]);
+            const bool try_reversed = reverse && len >= 2;
+
+            // Destino: entre n[q] e n[q+1], fora de [s-1, e]; extremos de prefix[e+1..q] para q > e
+            long long after_hi = load.prefix[e], after_lo = load.prefix[e];
+            for (size_t q = 0; q <= k; ++q) {
+                if (q + 1 >= s && q <= e) {
+                    continue;
+                }
+                if (q > e) {
+                    after_hi = std::max(after_hi, load.prefix[q]);
+                    after_lo = std::min(after_lo, load.prefix[q]);
+                }
+                const double gap = removal - data.getTravelCost(n[q], n[q + 1]);
+
+                for (int orientation = 0; orientation < (try_reversed ? 2 : 1); ++orientation) {
+                    const bool flip = orientation == 1;
+                    const int first = flip ? n[e] : n[s];
+                    const int last = flip ? n[s] : n[e];
+                    double delta = gap + data.getTravelCost(n[q], first) + data.getTravelCost(last, n[q + 1]) +
+                                   (flip ? reversal : 0.0);
+                    if (delta >= -kMinGain) continue;
+
+                    const RouteLoadWindow& chain = flip ? reversed : forward;
+                    bool feasible;
+                    if (q < s) {
+                        const long long from = load.prefix[q];
+                        RouteLoadWindow middle{load.prefix[s - 1] - from, std::max(0LL, before_max[q] - from),
+                                               std::min(0LL, before_min[q] - from)};
+                        feasible = Fits(HeadWindow(load, q), chain, middle, TailWindow(load, e + 1), Q);
+                    } else {
+                        const long long from = load.prefix[e];
+                        RouteLoadWindow middle{load.prefix[q] - from, after_hi - from, after_lo - from};
+                        feasible = Fits(HeadWindow(load, s - 1), middle, chain, TailWindow(load, q + 1), Q);
                     }
+                    if (!feasible) continue;
+
+                    move.a = static_cast<int>(s);
+                    move.b = static_cast<int>(q < s ? q + 1 : q + 1 - len);
+                    move.len = len;
+                    move.reversed = flip;
+                    move.delta = delta;
+                    ApplyOrOptMove(route, move);
+                    return true;
                 }
-
-                std::reverse(route.nodes.begin() + i, route.nodes.begin() + j + 1);
             }
         }
     }
@@ -33,8 +197,57 @@ bool TwoOptStep(const Data& data, Solution& solution, std::mt19937& rng) {
     return false;
 }
 
-bool RelocateStep(const Data& data, Solution& solution, std::mt19937& rng) {
+// Reaplica um movimento devolvido por FirstTwoOpt/FirstOrOpt
+void ApplyIntraMove(Route& route, RouteOptimaCache::Neighborhood neighborhood, const RouteOptimaCache::Move& move) {
+    if (neighborhood == RouteOptimaCache::kTwoOpt) {
+        std::reverse(route.nodes.begin() + move.a, route.nodes.begin() + move.b + 1);
+        return;
+    }
+    ApplyOrOptMove(route, move);
+}
+
+uint64_t HashSequence(const std::vector<int>& nodes) {
+    uint64_t h = Mix64(nodes.size());
+    for (int v : nodes) {
+        h = Mix64(h ^ static_cast<uint64_t>(v));
+    }
+    return h;
+}
+
+} // namespace
+
+bool TwoOptRoute(const Data& data, Route& route, double& delta) {
+    RouteOptimaCache::Move move;
+    if (!FirstTwoOpt(data, route, move)) return false;
+    delta = move.delta;
+    return true;
+}
+
+bool TwoOptStep(const Data& data, Solution& solution, std::mt19937& rng, double& predicted) {
+    for (Route& route : solution.routes) {
+        if (TwoOptRoute(data, route, predicted)) {
+            solution.total_cost += predicted;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Janelas de carga das rotas no início de um passo (as rotas só mudam quando o passo retorna)
+static std::vector<RouteLoadWindow> RouteWindows(const Data& data, const Solution& solution) {
+    std::vector<RouteLoadWindow> windows;
+    windows.reserve(solution.routes.size());
+    for (const Route& route : solution.routes) {
+        windows.push_back(LoadWindowOf(data, route));
+    }
+    return windows;
+}
+
+bool RelocateStep(const Data& data, Solution& solution, std::mt19937& rng, double& predicted) {
     double original_cost = solution.total_cost;
+    const long long Q = static_cast<long long>(data.getVehicleCapacity());
+    const std::vector<RouteLoadWindow> windows = RouteWindows(data, solution);
 
     for (size_t from_route_idx = 0; from_route_idx < solution.routes.size(); ++from_route_idx) {
         Route& from_route = solution.routes[from_route_idx];
@@ -46,8 +259,16 @@ bool RelocateStep(const Data& data, Solution& solution, std::mt19937& rng) {
 
             from_route.nodes.erase(from_route.nodes.begin() + client_pos);
 
+            // Sem o cliente, a rota de origem só volta a mudar em movimentos intra-rota
+            long long client_demand = NodeDemand(data, client);
+            bool from_ok = CheckRouteFeasible(data, from_route).ok;
+
             bool found_improvement = false;
             for (size_t to_route_idx = 0; to_route_idx < solution.routes.size() && !found_improvement; ++to_route_idx) {
+                if (to_route_idx != from_route_idx &&
+                    (!from_ok || !MayShiftSuffix(windows[to_route_idx], client_demand, Q))) {
+                    continue;
+                }
                 Route& to_route = solution.routes[to_route_idx];
 
                 for (size_t insert_pos = 1; insert_pos <= to_route.nodes.size() - 1 && !found_improvement; ++insert_pos) {
@@ -64,6 +285,7 @@ bool RelocateStep(const Data& data, Solution& solution, std::mt19937& rng) {
                         double new_cost = SolutionCost(data, solution);
 
                         if (new_cost < original_cost) {
+                            predicted = new_cost - original_cost;
                             solution.total_cost = new_cost;
                             return true;
                         }
@@ -80,9 +302,11 @@ bool RelocateStep(const Data& data, Solution& solution, std::mt19937& rng) {
     return false;
 }
 
-bool SwapStep(const Data& data, Solution& solution, std::mt19937& rng) {
+bool SwapStep(const Data& data, Solution& solution, std::mt19937& rng, double& predicted) {
     // Troca dois clientes entre rotas diferentes
     double original_cost = solution.total_cost;
+    const long long Q = static_cast<long long>(data.getVehicleCapacity());
+    const std::vector<RouteLoadWindow> windows = RouteWindows(data, solution);
 
     for (size_t route1_idx = 0; route1_idx < solution.routes.size(); ++route1_idx) {
         Route& route1 = solution.routes[route1_idx];
@@ -97,6 +321,13 @@ bool SwapStep(const Data& data, Solution& solution, std::mt19937& rng) {
             // Testa trocar cada par de clientes entre as rotas
             for (size_t pos1 = 1; pos1 < route1.nodes.size() - 1; ++pos1) {
                 for (size_t pos2 = 1; pos2 < route2.nodes.size() - 1; ++pos2) {
+                    // Cada rota troca um sufixo de prefixos por delta: filtro O(1) antes de testar
+                    long long delta = NodeDemand(data, route2.nodes[pos2]) - NodeDemand(data, route1.nodes[pos1]);
+                    if (!MayShiftSuffix(windows[route1_idx], delta, Q) ||
+                        !MayShiftSuffix(windows[route2_idx], -delta, Q)) {
+                        continue;
+                    }
+
                     // Troca clientes
                     std::swap(route1.nodes[pos1], route2.nodes[pos2]);
 
@@ -107,6 +338,7 @@ bool SwapStep(const Data& data, Solution& solution, std::mt19937& rng) {
                         double new_cost = SolutionCost(data, solution);
 
                         if (new_cost < original_cost) {
+                            predicted = new_cost - original_cost;
                             solution.total_cost = new_cost;
                             return true;
                         }
@@ -122,38 +354,125 @@ bool SwapStep(const Data& data, Solution& solution, std::mt19937& rng) {
     return false;
 }
 
-bool OrOpt2Step(const Data& data, Solution& solution, std::mt19937& rng) {
-    for (size_t route_idx = 0; route_idx < solution.routes.size(); ++route_idx) {
-        Route& route = solution.routes[route_idx];
+bool OrOpt2Route(const Data& data, Route& route, double& delta) {
+    RouteOptimaCache::Move move;
+    if (!FirstOrOpt(data, route, 2, 2, false, move)) return false;
+    delta = move.delta;
+    return true;
+}
 
-        if (route.nodes.size() < 5) continue;
+bool OrOpt2Step(const Data& data, Solution& solution, std::mt19937& rng, double& predicted) {
+    for (Route& route : solution.routes) {
+        if (OrOpt2Route(data, route, predicted)) {
+            solution.total_cost += predicted;
+            return true;
+        }
+    }
 
-        double original_cost = RouteCost(data, route);
+    return false;
+}
 
-        for (size_t start_pos = 1; start_pos < route.nodes.size() - 2; ++start_pos) {
-            std::vector<int> chain = {route.nodes[start_pos], route.nodes[start_pos + 1]};
+bool OrOptRoute(const Data& data, Route& route, int max_len, double& delta) {
+    RouteOptimaCache::Move move;
+    if (!FirstOrOpt(data, route, 1, max_len, true, move)) return false;
+    delta = move.delta;
+    return true;
+}
 
-            route.nodes.erase(route.nodes.begin() + start_pos, route.nodes.begin() + start_pos + 2);
+bool OrOptStep(const Data& data, Solution& solution, int max_len, double& predicted) {
+    for (Route& route : solution.routes) {
+        if (OrOptRoute(data, route, max_len, predicted)) {
+            solution.total_cost += predicted;
+            return true;
+        }
+    }
 
-            for (size_t insert_pos = 1; insert_pos < route.nodes.size(); ++insert_pos) {
-                if (insert_pos == start_pos) continue;
+    return false;
+}
 
-                route.nodes.insert(route.nodes.begin() + insert_pos, chain.begin(), chain.end());
+bool RouteOptimaCache::improve(const Data& data, Route& route, Neighborhood neighborhood, double& delta) {
+    uint64_t hash = HashSequence(route.nodes);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = entries.find(hash);
+        if (it != entries.end() && it->second.key == route.nodes) {
+            const Status& known = it->second.status[neighborhood];
+            if (known.state != kUnknown) {
+                hit_count++;
+                if (known.state == kOptimal) {
+                    return false;
+                }
+                ApplyIntraMove(route, neighborhood, known.move);
+                delta = known.move.delta;
+                return true;
+            }
+        }
+        miss_count++;
+    }
 
-                RouteFeasInfo feas_info = CheckRouteFeasible(data, route);
-                if (feas_info.ok) {
-                    double new_cost = RouteCost(data, route);
+    // Varredura fora do lock; a chave é a sequência antes do movimento
+    std::vector<int> key = route.nodes;
+    Status found;
+    bool improved;
+    switch (neighborhood) {
+        case kTwoOpt: improved = FirstTwoOpt(data, route, found.move); break;
+        case kOrOpt2: improved = FirstOrOpt(data, route, 2, 2, false, found.move); break;
+        default:      improved = FirstOrOpt(data, route, 1, or_opt_max, true, found.move); break;
+    }
+    found.state = improved ? kImproving : kOptimal;
+    if (improved) {
+        delta = found.move.delta;
+    }
 
-                    if (new_cost < original_cost) {
-                        solution.total_cost = SolutionCost(data, solution);
-                        return true;
-                    }
-                }
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(hash);
+    if (it == entries.end() || it->second.key != key) {
+        if (stored + key.size() > capacity) {
+            entries.clear();
+            stored = 0;
+        }
+        if (it != entries.end()) {
+            stored -= it->second.key.size();
+        }
+        stored += key.size();
+        Entry& entry = entries[hash];
+        entry.key = std::move(key);
+        entry.status = {};
+        entry.status[neighborhood] = found;
+    } else {
+        it->second.status[neighborhood] = found;
+    }
+    return improved;
+}
 
-                route.nodes.erase(route.nodes.begin() + insert_pos, route.nodes.begin() + insert_pos + 2);
-            }
+bool CachedTwoOptStep(const Data& data, Solution& solution, RouteOptimaCache& cache, double& predicted) {
+    for (Route& route : solution.routes) {
+        if (cache.improve(data, route, RouteOptimaCache::kTwoOpt, predicted)) {
+            solution.total_cost += predicted;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool CachedOrOpt2Step(const Data& data, Solution& solution, RouteOptimaCache& cache, double& predicted) {
+    for (Route& route : solution.routes) {
+        if (cache.improve(data, route, RouteOptimaCache::kOrOpt2, predicted)) {
+            solution.total_cost += predicted;
+            return true;
+        }
+    }
+
+    return false;
+}
 
-            route.nodes.insert(route.nodes.begin() + start_pos, chain.begin(), chain.end());
+bool CachedOrOptStep(const Data& data, Solution& solution, RouteOptimaCache& cache, double& predicted) {
+    for (Route& route : solution.routes) {
+        if (cache.improve(data, route, RouteOptimaCache::kOrOpt, predicted)) {
+            solution.total_cost += predicted;
+            return true;
         }
     }
 
@@ -170,9 +489,15 @@ Solution VND(const Data& data, Solution start, std::mt19937& rng,
     int improvements_count = 0;
 
     while (k < static_cast<int>(neighborhoods.size())) {
-        bool improved = neighborhoods[k](data, current_solution, rng);
+        const bool verify = VerifyNextMove();
+        const double before = current_solution.total_cost;
+        double predicted = 0.0;
+        bool improved = neighborhoods[k](data, current_solution, rng, predicted);
 
         if (improved) {
+            if (verify) {
+                VerifyMove(data, current_solution, "vnd", before, predicted);
+            }
             k = 0;
             improvements_count++;
         } else {
@@ -192,21 +517,55 @@ std::vector<NeighborhoodFunction> GetDefaultNeighborhoods() {
     };
 }
 
-Solution RVND(const Data& data, const Solution& start, std::mt19937& rng) {
-    auto neighborhoods = GetDefaultNeighborhoods();
+const std::vector<std::string>& GetDefaultNeighborhoodNames() {
+    static const std::vector<std::string> names = {
+        "relocate",
+        "swap",
+        "2opt",
+        "oropt2"
+    };
+    return names;
+}
+
+Solution VND(const Data& data, Solution start, std::mt19937& rng) {
+    return VNDWith(data, std::move(start), rng, DefaultPipeline{});
+}
+
+Solution RVND(const Data& data, const Solution& start, std::mt19937& rng, RVNDStats* stats) {
+    return RVNDWith(data, start, rng, DefaultPipeline{}, stats);
+}
+
+Solution RVND(const Data& data, const Solution& start, std::mt19937& rng,
+              const std::vector<NeighborhoodFunction>& neighborhoods, const std::vector<std::string>& names,
+              RVNDStats* stats) {
+    // Embaralha índices (mesma sequência de sorteios que embaralhar as funções)
+    std::vector<int> order(neighborhoods.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = static_cast<int>(i);
+    }
     
     Solution current_solution = start;
     current_solution.total_cost = SolutionCost(data, current_solution);
 
-    std::shuffle(neighborhoods.begin(), neighborhoods.end(), rng);
+    std::shuffle(order.begin(), order.end(), rng);
 
     int k = 0;
 
-    while (k < static_cast<int>(neighborhoods.size())) {
-        bool improved = neighborhoods[k](data, current_solution, rng);
+    while (k < static_cast<int>(order.size())) {
+        const bool verify = VerifyNextMove();
+        const double before = current_solution.total_cost;
+        double predicted = 0.0;
+        bool improved = neighborhoods[order[k]](data, current_solution, rng, predicted);
 
         if (improved) {
-            std::shuffle(neighborhoods.begin(), neighborhoods.end(), rng);
+            if (verify) {
+                VerifyMove(data, current_solution, names[order[k]].c_str(), before, predicted);
+            }
+            if (stats) {
+                stats->improvements++;
+                stats->last_improving = names[order[k]].c_str();
+            }
+            std::shuffle(order.begin(), order.end(), rng);
             k = 0;
         } else {
             k++;
@@ -214,4 +573,4 @@ Solution RVND(const Data& data, const Solution& start, std::mt19937& rng) {
     }
 
     return current_solution;
-}
\ No newline at end of file
+}
@@ -1,25 +1,274 @@
 #ifndef LOCAL_SEARCH_H
 #define LOCAL_SEARCH_H
 
+#include <algorithm>
+#include <array>
 #include <vector>
 #include <functional>
+#include <mutex>
+#include <numeric>
 #include <random>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
 #include "Construction.h"
 #include "Instance.h"
+#include "Verify.h"
 
-using NeighborhoodFunction = std::function<bool(const Data&, Solution&, std::mt19937&)>;
+// Passo de vizinhança: aplica a primeira melhora e retorna true. `predicted` recebe a variação
+// de custo calculada pelo avaliador do próprio passo, conferida por --verify contra SolutionCost
+using NeighborhoodFunction = std::function<bool(const Data&, Solution&, std::mt19937&, double&)>;
 
-bool TwoOptStep(const Data& data, Solution& solution, std::mt19937& rng);
-bool RelocateStep(const Data& data, Solution& solution, std::mt19937& rng);
-bool SwapStep(const Data& data, Solution& solution, std::mt19937& rng);
-bool OrOpt2Step(const Data& data, Solution& solution, std::mt19937& rng);
+bool TwoOptStep(const Data& data, Solution& solution, std::mt19937& rng, double& predicted);
+bool RelocateStep(const Data& data, Solution& solution, std::mt19937& rng, double& predicted);
+bool SwapStep(const Data& data, Solution& solution, std::mt19937& rng, double& predicted);
+bool OrOpt2Step(const Data& data, Solution& solution, std::mt19937& rng, double& predicted);
+
+// Primeira melhora intra-rota numa única rota (a rota é alterada só se retornar true; `delta`
+// recebe a variação do custo da rota)
+bool TwoOptRoute(const Data& data, Route& route, double& delta);
+bool OrOpt2Route(const Data& data, Route& route, double& delta);
+
+// Or-opt intra-rota generalizado: trechos de 1 a max_len estações reinseridos em outra posição
+// da mesma rota, na ordem original ou invertidos. Cada candidato é avaliado em O(1) (custos
+// acumulados nos dois sentidos e janelas de carga), como no 2-opt e no Or-opt-2. Os passos
+// intra-rota (também os com cache) somam essa variação a total_cost, sem recalcular a solução.
+bool OrOptRoute(const Data& data, Route& route, int max_len, double& delta);
+bool OrOptStep(const Data& data, Solution& solution, int max_len, double& predicted);
+
+// Cache de otimalidade intra-rota: para cada sequência de rota já varrida guarda, por
+// vizinhança, se ela não tem movimento de melhora ou qual é o primeiro (as varreduras
+// intra-rota são determinísticas, então o resultado é idêntico ao da varredura). Limitado a
+// `capacity` nós de chave; ao encher, é esvaziado. Seguro para uso entre threads.
+class RouteOptimaCache {
+public:
+    enum Neighborhood { kTwoOpt = 0, kOrOpt2 = 1, kOrOpt = 2 };
+
+    // Movimento intra-rota: 2-opt inverte [a, b]; Or-opt leva o trecho de len estações em a
+    // (invertido se reversed) para a posição b da rota sem ele. delta: variação do custo da rota
+    struct Move {
+        int    a = 0;
+        int    b = 0;
+        int    len = 2;
+        bool   reversed = false;
+        double delta = 0.0;
+    };
+
+    // or_opt_max: maior trecho de kOrOpt (OrOptRoute), fixo para o cache inteiro
+    explicit RouteOptimaCache(size_t capacity = size_t{1} << 22, int or_opt_max = 3)
+        : capacity(capacity), or_opt_max(or_opt_max) {}
+
+    // Mesmo efeito de TwoOptRoute/OrOpt2Route/OrOptRoute, sem varrer rotas já conhecidas
+    bool improve(const Data& data, Route& route, Neighborhood neighborhood, double& delta);
+
+    [[nodiscard]] long long hits() const { return hit_count; }
+    [[nodiscard]] long long misses() const { return miss_count; }
+
+private:
+    enum State : unsigned char { kUnknown, kOptimal, kImproving };
+    struct Status {
+        State state = kUnknown;
+        Move  move;
+    };
+    struct Entry {
+        std::vector<int>      key;  // sequência completa da rota (confere colisões do hash)
+        std::array<Status, 3> status;
+    };
+
+    size_t capacity;
+    int or_opt_max;
+    size_t stored = 0;
+    std::mutex mutex;
+    std::unordered_map<uint64_t, Entry> entries;
+    long long hit_count = 0;
+    long long miss_count = 0;
+};
+
+// TwoOptStep/OrOpt2Step consultando o cache (mesmas melhoras, mesma ordem)
+bool CachedTwoOptStep(const Data& data, Solution& solution, RouteOptimaCache& cache, double& predicted);
+bool CachedOrOpt2Step(const Data& data, Solution& solution, RouteOptimaCache& cache, double& predicted);
+bool CachedOrOptStep(const Data& data, Solution& solution, RouteOptimaCache& cache, double& predicted);
+
+// Vizinhanças como tipos, para pipelines montados em tempo de compilação: cada uma tem um
+// nome (kName, o mesmo de GetDefaultNeighborhoodNames) e operator() com a assinatura de
+// NeighborhoodFunction
+struct RelocateNeighborhood {
+    static constexpr const char* kName = "relocate";
+    bool operator()(const Data& data, Solution& solution, std::mt19937& rng, double& predicted) const {
+        return RelocateStep(data, solution, rng, predicted);
+    }
+};
+
+struct SwapNeighborhood {
+    static constexpr const char* kName = "swap";
+    bool operator()(const Data& data, Solution& solution, std::mt19937& rng, double& predicted) const {
+        return SwapStep(data, solution, rng, predicted);
+    }
+};
+
+struct TwoOptNeighborhood {
+    static constexpr const char* kName = "2opt";
+    bool operator()(const Data& data, Solution& solution, std::mt19937& rng, double& predicted) const {
+        return TwoOptStep(data, solution, rng, predicted);
+    }
+};
+
+struct OrOpt2Neighborhood {
+    static constexpr const char* kName = "oropt2";
+    bool operator()(const Data& data, Solution& solution, std::mt19937& rng, double& predicted) const {
+        return OrOpt2Step(data, solution, rng, predicted);
+    }
+};
+
+struct OrOptNeighborhood {
+    static constexpr const char* kName = "oropt";
+    int max_len;
+    bool operator()(const Data& data, Solution& solution, std::mt19937&, double& predicted) const {
+        return OrOptStep(data, solution, max_len, predicted);
+    }
+};
+
+struct CachedTwoOptNeighborhood {
+    static constexpr const char* kName = "2opt";
+    RouteOptimaCache& cache;
+    bool operator()(const Data& data, Solution& solution, std::mt19937&, double& predicted) const {
+        return CachedTwoOptStep(data, solution, cache, predicted);
+    }
+};
+
+struct CachedOrOpt2Neighborhood {
+    static constexpr const char* kName = "oropt2";
+    RouteOptimaCache& cache;
+    bool operator()(const Data& data, Solution& solution, std::mt19937&, double& predicted) const {
+        return CachedOrOpt2Step(data, solution, cache, predicted);
+    }
+};
+
+struct CachedOrOptNeighborhood {
+    static constexpr const char* kName = "oropt";
+    RouteOptimaCache& cache;
+    bool operator()(const Data& data, Solution& solution, std::mt19937&, double& predicted) const {
+        return CachedOrOptStep(data, solution, cache, predicted);
+    }
+};
+
+// Lista de vizinhanças fixada em tempo de compilação. apply(k) despacha por uma cadeia de
+// comparações com chamadas diretas, que o compilador pode expandir no laço do RVND/VND, em vez
+// da chamada indireta de std::function. Sem estado próprio: pode ser usado entre threads se as
+// vizinhanças puderem.
+template <typename... Neighborhoods>
+class NeighborhoodPipeline {
+public:
+    static constexpr size_t kSize = sizeof...(Neighborhoods);
+    static constexpr std::array<const char*, kSize> kNames = {Neighborhoods::kName...};
+
+    NeighborhoodPipeline() = default;
+    explicit NeighborhoodPipeline(Neighborhoods... neighborhoods) : steps(std::move(neighborhoods)...) {}
+
+    bool apply(size_t k, const Data& data, Solution& solution, std::mt19937& rng, double& predicted) const {
+        return dispatch(k, data, solution, rng, predicted, std::index_sequence_for<Neighborhoods...>{});
+    }
+
+private:
+    template <size_t... I>
+    bool dispatch(size_t k, const Data& data, Solution& solution, std::mt19937& rng, double& predicted,
+                  std::index_sequence<I...>) const {
+        bool improved = false;
+        (void)((k == I && (improved = std::get<I>(steps)(data, solution, rng, predicted), true)) || ...);
+        return improved;
+    }
+
+    std::tuple<Neighborhoods...> steps;
+};
+
+using DefaultPipeline = NeighborhoodPipeline<RelocateNeighborhood, SwapNeighborhood, TwoOptNeighborhood,
+                                             OrOpt2Neighborhood>;
+using CachedPipeline = NeighborhoodPipeline<RelocateNeighborhood, SwapNeighborhood, CachedTwoOptNeighborhood,
+                                            CachedOrOpt2Neighborhood>;
+// Or-opt-1..K com inversão no lugar do Or-opt-2 (K de OrOptNeighborhood / do cache)
+using OrOptPipeline = NeighborhoodPipeline<RelocateNeighborhood, SwapNeighborhood, TwoOptNeighborhood,
+                                           OrOptNeighborhood>;
+using CachedOrOptPipeline = NeighborhoodPipeline<RelocateNeighborhood, SwapNeighborhood, CachedTwoOptNeighborhood,
+                                                 CachedOrOptNeighborhood>;
 
 Solution VND(const Data& data, Solution start, std::mt19937& rng,
              std::vector<NeighborhoodFunction> neighborhoods);
+// VND com as vizinhanças padrão (DefaultPipeline)
+Solution VND(const Data& data, Solution start, std::mt19937& rng);
 
 std::vector<NeighborhoodFunction> GetDefaultNeighborhoods();
+// Nomes na mesma ordem de GetDefaultNeighborhoods()
+const std::vector<std::string>& GetDefaultNeighborhoodNames();
+
+struct RVNDStats {
+    int         improvements   = 0;
+    const char* last_improving = nullptr;  // vizinhança da última melhora (nullptr se nenhuma)
+};
 
 [[nodiscard]] Solution RVND(const Data& data, const Solution& start,
-                            std::mt19937& rng);
+                            std::mt19937& rng, RVNDStats* stats = nullptr);
+// RVND sobre outra lista de vizinhanças montada em tempo de execução (experimentos); names
+// na mesma ordem (para RVNDStats)
+[[nodiscard]] Solution RVND(const Data& data, const Solution& start, std::mt19937& rng,
+                            const std::vector<NeighborhoodFunction>& neighborhoods,
+                            const std::vector<std::string>& names, RVNDStats* stats = nullptr);
+
+// VND e RVND especializados para um NeighborhoodPipeline. Mesmos movimentos e mesma sequência
+// de sorteios que as versões com NeighborhoodFunction sobre a mesma lista.
+template <typename Pipeline>
+[[nodiscard]] Solution VNDWith(const Data& data, Solution start, std::mt19937& rng, const Pipeline& pipeline) {
+    Solution current_solution = std::move(start);
+    current_solution.total_cost = SolutionCost(data, current_solution);
+
+    size_t k = 0;
+    while (k < Pipeline::kSize) {
+        const bool verify = VerifyNextMove();
+        const double before = current_solution.total_cost;
+        double predicted = 0.0;
+        if (pipeline.apply(k, data, current_solution, rng, predicted)) {
+            if (verify) {
+                VerifyMove(data, current_solution, Pipeline::kNames[k], before, predicted);
+            }
+            k = 0;
+        } else {
+            k++;
+        }
+    }
+    return current_solution;
+}
+
+template <typename Pipeline>
+[[nodiscard]] Solution RVNDWith(const Data& data, const Solution& start, std::mt19937& rng, const Pipeline& pipeline,
+                                RVNDStats* stats = nullptr) {
+    std::array<int, Pipeline::kSize> order;
+    std::iota(order.begin(), order.end(), 0);
+
+    Solution current_solution = start;
+    current_solution.total_cost = SolutionCost(data, current_solution);
+
+    std::shuffle(order.begin(), order.end(), rng);
+
+    size_t k = 0;
+    while (k < Pipeline::kSize) {
+        const bool verify = VerifyNextMove();
+        const double before = current_solution.total_cost;
+        double predicted = 0.0;
+        if (pipeline.apply(static_cast<size_t>(order[k]), data, current_solution, rng, predicted)) {
+            if (verify) {
+                VerifyMove(data, current_solution, Pipeline::kNames[order[k]], before, predicted);
+            }
+            if (stats) {
+                stats->improvements++;
+                stats->last_improving = Pipeline::kNames[order[k]];
+            }
+            std::shuffle(order.begin(), order.end(), rng);
+            k = 0;
+        } else {
+            k++;
+        }
+    }
+    return current_solution;
+}
 
 #endif
\ No newline at end of file
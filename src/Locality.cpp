@@ -0,0 +1,57 @@
+#include "Locality.h"
+#include <limits>
+
+std::vector<int> LocalityOrder(const Data& data) {
+    const int n = data.getNumStations();
+    std::vector<int> order;
+    order.reserve(n);
+
+    std::vector<int> pending(n);
+    for (int v = 1; v <= n; ++v) {
+        pending[v - 1] = v;
+    }
+
+    int current = 0;
+    while (!pending.empty()) {
+        size_t best = 0;
+        double best_cost = std::numeric_limits<double>::infinity();
+        for (size_t k = 0; k < pending.size(); ++k) {
+            double cost = data.getTravelCost(current, pending[k]);
+            if (cost < best_cost || (cost == best_cost && pending[k] < pending[best])) {
+                best_cost = cost;
+                best = k;
+            }
+        }
+        current = pending[best];
+        order.push_back(current);
+        pending[best] = pending.back();
+        pending.pop_back();
+    }
+    return order;
+}
+
+namespace {
+
+template <typename Map>
+Solution MapIds(const Data& data, const Solution& solution, Map map) {
+    const int n = data.getNumStations();
+    Solution mapped = solution;
+    for (Route& route : mapped.routes) {
+        for (int& v : route.nodes) {
+            if (v >= 0 && v <= n) {
+                v = map(v);
+            }
+        }
+    }
+    return mapped;
+}
+
+} // namespace
+
+Solution ToOriginalIds(const Data& data, const Solution& solution) {
+    return MapIds(data, solution, [&](int v) { return data.getOriginalId(v); });
+}
+
+Solution ToInternalIds(const Data& data, const Solution& solution) {
+    return MapIds(data, solution, [&](int v) { return data.getInternalId(v); });
+}
@@ -0,0 +1,19 @@
+#ifndef LOCALITY_H
+#define LOCALITY_H
+
+#include <vector>
+#include "Construction.h"
+#include "Instance.h"
+
+// Ordem de localidade das estações (cadeia do vizinho mais próximo pela matriz): começa na
+// estação mais próxima do depósito e segue sempre para a pendente mais próxima da atual,
+// desempate pelo menor id. Estações próximas na matriz ficam com ids próximos, então as
+// linhas/colunas lidas juntas pela busca local compartilham linhas de cache. O(n²).
+[[nodiscard]] std::vector<int> LocalityOrder(const Data& data);
+
+// Ids de uma solução entre a numeração interna e a do arquivo de entrada. Ids fora do
+// intervalo 0..n são mantidos (o reparo do warm start os descarta).
+[[nodiscard]] Solution ToOriginalIds(const Data& data, const Solution& solution);
+[[nodiscard]] Solution ToInternalIds(const Data& data, const Solution& solution);
+
+#endif
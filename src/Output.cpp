@@ -2,6 +2,7 @@
 #include <fstream>
 #include <iostream>
 #include <filesystem>
+#include <sstream>
 
 void WriteSolution(const std::string& path, const Data& data, const Solution& solution) {
     // Cria diretório de saída se não existir
@@ -20,10 +21,11 @@ void WriteSolution(const std::string& path, const Data& data, const Solution& so
     // Linha 2: Número de veículos utilizados
     outFile << solution.routes.size() << std::endl;
 
-    // Linhas seguintes: Rotas (cada uma iniciando e terminando com 0)
+    // Linhas seguintes: Rotas (cada uma iniciando e terminando com 0), com os ids do arquivo
+    // de entrada mesmo que a instância tenha sido renumerada
     for (const auto& route : solution.routes) {
         for (size_t i = 0; i < route.nodes.size(); ++i) {
-            outFile << route.nodes[i];
+            outFile << data.getOriginalId(route.nodes[i]);
             if (i < route.nodes.size() - 1) {
                 outFile << " ";
             }
@@ -33,4 +35,38 @@ void WriteSolution(const std::string& path, const Data& data, const Solution& so
 
     outFile.close();
     std::cout << "Solução salva em: " << path << std::endl;
+}
+
+bool ReadSolution(const std::string& path, Solution& solution) {
+    std::ifstream inFile(path);
+    if (!inFile) {
+        std::cout << "Erro: arquivo de solução não encontrado: " << path << std::endl;
+        return false;
+    }
+
+    size_t vehicles = 0;
+    if (!(inFile >> solution.total_cost >> vehicles)) {
+        std::cout << "Erro: cabeçalho inválido em " << path << std::endl;
+        return false;
+    }
+
+    solution.routes.clear();
+    std::string line;
+    while (std::getline(inFile, line)) {
+        std::istringstream route_stream(line);
+        Route route;
+        int node;
+        while (route_stream >> node) {
+            route.nodes.push_back(node);
+        }
+        if (!route.nodes.empty()) {
+            solution.routes.push_back(route);
+        }
+    }
+
+    if (solution.routes.size() != vehicles) {
+        std::cout << "Aviso: " << path << " declara " << vehicles << " rotas, mas contém "
+                  << solution.routes.size() << std::endl;
+    }
+    return true;
 }
\ No newline at end of file
@@ -4,6 +4,10 @@
 #include <string>
 #include "Construction.h"
 
+// Escreve as rotas com os ids originais (ver Data::renumber)
 void WriteSolution(const std::string& path, const Data& data, const Solution& solution);
 
+// Lê um .out no formato escrito por WriteSolution; rotas são lidas como estão (sem validação)
+bool ReadSolution(const std::string& path, Solution& solution);
+
 #endif
\ No newline at end of file
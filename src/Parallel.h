@@ -0,0 +1,120 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Executa fn(0..count-1) em até `threads` threads (a thread chamadora incluída). Os índices
+// são distribuídos sob demanda; quem precisa de resultado determinístico grava por índice e
+// reduz na ordem dos índices depois.
+inline void ParallelFor(int count, int threads, const std::function<void(int)>& fn) {
+    std::atomic<int> next{0};
+    auto worker = [&]() {
+        for (int k = next++; k < count; k = next++) {
+            fn(k);
+        }
+    };
+
+    int workers = std::min(threads, count);
+    std::vector<std::thread> pool;
+    for (int w = 1; w < workers; ++w) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& th : pool) {
+        th.join();
+    }
+}
+
+// Threads criadas uma vez e reaproveitadas a cada run(), para laços curtos repetidos muitas
+// vezes (um por passo de uma construção), onde criar e juntar threads a cada laço pesaria mais
+// que o próprio trabalho. run() tem a semântica de ParallelFor, com a thread chamadora incluída.
+class WorkerPool {
+public:
+    explicit WorkerPool(int threads) {
+        for (int w = 1; w < threads; ++w) {
+            workers_.emplace_back([this]() { loop(); });
+        }
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (std::thread& th : workers_) {
+            th.join();
+        }
+    }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    void run(int count, const std::function<void(int)>& fn) {
+        if (workers_.empty()) {
+            for (int k = 0; k < count; ++k) {
+                fn(k);
+            }
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            fn_ = &fn;
+            count_ = count;
+            next_ = 0;
+            active_ = static_cast<int>(workers_.size());
+            ++generation_;
+        }
+        wake_.notify_all();
+        drain();
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this]() { return active_ == 0; });
+        fn_ = nullptr;
+    }
+
+private:
+    void drain() {
+        for (int k = next_++; k < count_; k = next_++) {
+            (*fn_)(k);
+        }
+    }
+
+    // Cada worker espera uma nova geração (um run()), ajuda a esvaziar os índices e avisa
+    // quando termina; run() só volta depois que todos os workers saíram de drain()
+    void loop() {
+        unsigned long seen = 0;
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            wake_.wait(lock, [&]() { return stop_ || generation_ != seen; });
+            if (stop_) {
+                return;
+            }
+            seen = generation_;
+            lock.unlock();
+            drain();
+            lock.lock();
+            if (--active_ == 0) {
+                done_.notify_one();
+            }
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    const std::function<void(int)>* fn_ = nullptr;
+    int count_ = 0;
+    std::atomic<int> next_{0};
+    int active_ = 0;
+    unsigned long generation_ = 0;
+    bool stop_ = false;
+};
+
+#endif
@@ -0,0 +1,268 @@
+#include "PathRelinking.h"
+#include "Feasibility.h"
+#include "Verify.h"
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+// Movimentos avaliados por passo do caminho (janela do início da lista embaralhada)
+constexpr size_t kRelinkCandidates = 32;
+
+std::vector<int> Successors(const Data& data, const Solution& solution) {
+    std::vector<int> succ(data.getNumStations() + 1, -1);
+    for (const Route& route : solution.routes) {
+        for (size_t i = 1; i + 1 < route.nodes.size(); ++i) {
+            succ[route.nodes[i]] = route.nodes[i + 1];
+        }
+    }
+    return succ;
+}
+
+Solution WithoutEmptyRoutes(const Solution& solution) {
+    Solution compact;
+    compact.total_cost = solution.total_cost;
+    for (const Route& route : solution.routes) {
+        if (route.nodes.size() > 2) {
+            compact.routes.push_back(route);
+        }
+    }
+    return compact;
+}
+
+} // namespace
+
+double RouteDistance(const Data& data, const Solution& a, const Solution& b) {
+    const int n = data.getNumStations();
+    if (n == 0) {
+        return 0.0;
+    }
+    std::vector<int> succ_a = Successors(data, a);
+    std::vector<int> succ_b = Successors(data, b);
+
+    int differing = 0;
+    for (int v = 1; v <= n; ++v) {
+        if (succ_a[v] != succ_b[v]) {
+            differing++;
+        }
+    }
+    return static_cast<double>(differing) / n;
+}
+
+ElitePool::ElitePool(const Data& data, int capacity, double min_distance)
+    : data(data), max_size(capacity), min_distance(min_distance) {}
+
+bool ElitePool::add(const Solution& solution) {
+    if (max_size <= 0 || solution.routes.empty()) {
+        return false;
+    }
+
+    int closest = -1;
+    double closest_distance = std::numeric_limits<double>::infinity();
+    for (int i = 0; i < size(); ++i) {
+        double d = RouteDistance(data, solution, elites[i]);
+        if (d < closest_distance) {
+            closest_distance = d;
+            closest = i;
+        }
+    }
+
+    if (closest >= 0 && closest_distance < min_distance) {
+        if (solution.total_cost >= elites[closest].total_cost) {
+            return false;
+        }
+        elites[closest] = solution;
+    } else if (size() < max_size) {
+        elites.push_back(solution);
+    } else if (solution.total_cost < elites.back().total_cost) {
+        elites.back() = solution;
+    } else {
+        return false;
+    }
+
+    std::stable_sort(elites.begin(), elites.end(),
+                     [](const Solution& x, const Solution& y) { return x.total_cost < y.total_cost; });
+    return true;
+}
+
+Solution PathRelink(const Data& data, const Solution& initial, const Solution& guiding, std::mt19937& rng,
+                    int search_points, RVNDStats* stats) {
+    const int n = data.getNumStations();
+    const long long Q = static_cast<long long>(data.getVehicleCapacity());
+
+    Solution current = initial;
+    current.total_cost = SolutionCost(data, current);
+
+    std::vector<int> route_of(n + 1, -1);
+    for (size_t r = 0; r < current.routes.size(); ++r) {
+        for (size_t i = 1; i + 1 < current.routes[r].nodes.size(); ++i) {
+            route_of[current.routes[r].nodes[i]] = static_cast<int>(r);
+        }
+    }
+    std::vector<int> guide_route(n + 1, -1);
+    for (size_t g = 0; g < guiding.routes.size(); ++g) {
+        for (size_t i = 1; i + 1 < guiding.routes[g].nodes.size(); ++i) {
+            guide_route[guiding.routes[g].nodes[i]] = static_cast<int>(g);
+        }
+    }
+
+    // Pareia rotas guia -> rotas correntes pela maior sobreposição de estações (guloso)
+    const size_t C = current.routes.size();
+    std::vector<long long> keys;
+    for (int v = 1; v <= n; ++v) {
+        if (guide_route[v] >= 0 && route_of[v] >= 0) {
+            keys.push_back(static_cast<long long>(guide_route[v]) * static_cast<long long>(C) + route_of[v]);
+        }
+    }
+    std::sort(keys.begin(), keys.end());
+    struct Overlap {
+        int count;
+        int guide;
+        int route;
+    };
+    std::vector<Overlap> overlaps;
+    for (size_t i = 0; i < keys.size();) {
+        size_t j = i;
+        while (j < keys.size() && keys[j] == keys[i]) {
+            ++j;
+        }
+        overlaps.push_back({static_cast<int>(j - i), static_cast<int>(keys[i] / static_cast<long long>(C)),
+                            static_cast<int>(keys[i] % static_cast<long long>(C))});
+        i = j;
+    }
+    std::stable_sort(overlaps.begin(), overlaps.end(),
+                     [](const Overlap& a, const Overlap& b) { return a.count > b.count; });
+
+    std::vector<int> target(guiding.routes.size(), -1);
+    std::vector<char> used(C, 0);
+    for (const Overlap& o : overlaps) {
+        if (target[o.guide] < 0 && !used[o.route]) {
+            target[o.guide] = o.route;
+            used[o.route] = 1;
+        }
+    }
+    // Rotas guia sem par ganham uma rota vazia, se houver veículo
+    for (size_t g = 0; g < target.size(); ++g) {
+        if (target[g] < 0 && static_cast<int>(current.routes.size()) < data.getNumVehicles()) {
+            target[g] = static_cast<int>(current.routes.size());
+            current.routes.push_back(Route{{0, 0}});
+        }
+    }
+
+    std::vector<int> pending;
+    for (int v = 1; v <= n; ++v) {
+        if (guide_route[v] >= 0 && target[guide_route[v]] >= 0 && route_of[v] >= 0 &&
+            route_of[v] != target[guide_route[v]]) {
+            pending.push_back(v);
+        }
+    }
+    std::shuffle(pending.begin(), pending.end(), rng);
+
+    std::vector<RouteLoadProfile> profiles(current.routes.size());
+    std::vector<char> stale(current.routes.size(), 1);
+    auto profile_of = [&](int r) -> const RouteLoadProfile& {
+        if (stale[r]) {
+            BuildLoadProfile(data, current.routes[r], profiles[r]);
+            stale[r] = 0;
+        }
+        return profiles[r];
+    };
+
+    Solution best;
+    best.total_cost = std::numeric_limits<double>::infinity();
+
+    const size_t path_length = pending.size();
+    int next_point = 1;
+    size_t step = 0;
+
+    while (!pending.empty()) {
+        struct Move {
+            size_t index;
+            size_t from_pos;
+            size_t to_pos;
+            double delta;
+        };
+        Move best_move{0, 0, 0, std::numeric_limits<double>::infinity()};
+        std::vector<size_t> blocked;
+
+        size_t window = std::min(pending.size(), kRelinkCandidates);
+        for (size_t k = 0; k < window; ++k) {
+            int v = pending[k];
+            int r = route_of[v];
+            int t = target[guide_route[v]];
+            const std::vector<int>& from = current.routes[r].nodes;
+            size_t from_pos = static_cast<size_t>(std::find(from.begin(), from.end(), v) - from.begin());
+            long long d = NodeDemand(data, v);
+
+            if (!CanRemoveAt(profile_of(r), from_pos, d, Q)) {
+                blocked.push_back(k);
+                continue;
+            }
+            double removal = data.getTravelCost(from[from_pos - 1], from[from_pos + 1]) -
+                             data.getTravelCost(from[from_pos - 1], v) - data.getTravelCost(v, from[from_pos + 1]);
+
+            const std::vector<int>& to = current.routes[t].nodes;
+            const RouteLoadProfile& to_profile = profile_of(t);
+            bool inserted = false;
+            for (size_t pos = 1; pos < to.size(); ++pos) {
+                if (!CanInsertAt(to_profile, pos, d, Q)) {
+                    continue;
+                }
+                inserted = true;
+                double delta = removal + data.getTravelCost(to[pos - 1], v) + data.getTravelCost(v, to[pos]) -
+                               data.getTravelCost(to[pos - 1], to[pos]);
+                if (delta < best_move.delta) {
+                    best_move = {k, from_pos, pos, delta};
+                }
+            }
+            if (!inserted) {
+                blocked.push_back(k);
+            }
+        }
+
+        if (best_move.delta == std::numeric_limits<double>::infinity()) {
+            // Nenhum movimento viável na janela: descarta esses candidatos e segue
+            for (auto it = blocked.rbegin(); it != blocked.rend(); ++it) {
+                pending.erase(pending.begin() + static_cast<long>(*it));
+            }
+            continue;
+        }
+
+        int v = pending[best_move.index];
+        int r = route_of[v];
+        int t = target[guide_route[v]];
+        const double before = current.total_cost;
+        current.routes[r].nodes.erase(current.routes[r].nodes.begin() + static_cast<long>(best_move.from_pos));
+        current.routes[t].nodes.insert(current.routes[t].nodes.begin() + static_cast<long>(best_move.to_pos), v);
+        current.total_cost += best_move.delta;
+        if (VerifyNextMove()) {
+            VerifyMove(data, current, "relink", before, best_move.delta);
+        }
+        route_of[v] = t;
+        stale[r] = stale[t] = 1;
+        pending.erase(pending.begin() + static_cast<long>(best_move.index));
+        ++step;
+
+        // Pontos intermediários (a extremidade guia não conta)
+        if (pending.empty()) {
+            break;
+        }
+        if (current.total_cost < best.total_cost) {
+            best = WithoutEmptyRoutes(current);
+        }
+        if (next_point <= search_points &&
+            step * static_cast<size_t>(search_points + 1) >= path_length * static_cast<size_t>(next_point)) {
+            ++next_point;
+            Solution improved = RVND(data, WithoutEmptyRoutes(current), rng, stats);
+            if (improved.total_cost < best.total_cost) {
+                best = std::move(improved);
+            }
+        }
+    }
+
+    if (best.routes.empty()) {
+        return WithoutEmptyRoutes(initial);
+    }
+    best.total_cost = SolutionCost(data, best);
+    return best;
+}
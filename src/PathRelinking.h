@@ -0,0 +1,44 @@
+#ifndef PATH_RELINKING_H
+#define PATH_RELINKING_H
+
+#include <random>
+#include <vector>
+#include "Construction.h"
+#include "Instance.h"
+#include "LocalSearch.h"
+
+// Distância entre soluções pelas rotas: fração das estações cujo sucessor difere, com o
+// depósito contando como sucessor. Só o sucessor é comparado (arcos orientados, já que os
+// custos podem ser assimétricos): uma rota invertida conta como quase toda diferente.
+// 0 = mesmas rotas, 1 = nenhuma estação com o mesmo sucessor.
+[[nodiscard]] double RouteDistance(const Data& data, const Solution& a, const Solution& b);
+
+// Conjunto elite limitado de ótimos locais, ordenado por custo. Uma solução a menos de
+// min_distance de alguma elite só entra substituindo-a, e só se for melhor; do contrário
+// entra no lugar da pior quando o conjunto está cheio.
+class ElitePool {
+public:
+    ElitePool(const Data& data, int capacity, double min_distance = 0.05);
+
+    // true se a solução entrou no conjunto
+    bool add(const Solution& solution);
+
+    [[nodiscard]] int size() const { return static_cast<int>(elites.size()); }
+    [[nodiscard]] int capacity() const { return max_size; }
+    [[nodiscard]] const Solution& operator[](int i) const { return elites[i]; }
+
+private:
+    const Data& data;
+    int max_size;
+    double min_distance;
+    std::vector<Solution> elites;
+};
+
+// Caminha de `initial` em direção a `guiding` movendo, um de cada vez, as estações cuja rota
+// difere (rotas pareadas pela maior sobreposição), escolhendo o movimento viável mais barato.
+// Em `search_points` pontos intermediários do caminho roda o RVND. Devolve a melhor solução
+// viável encontrada no caminho (diferente das extremidades sempre que possível).
+[[nodiscard]] Solution PathRelink(const Data& data, const Solution& initial, const Solution& guiding,
+                                  std::mt19937& rng, int search_points = 3, RVNDStats* stats = nullptr);
+
+#endif
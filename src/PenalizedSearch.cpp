@@ -0,0 +1,339 @@
+#include "PenalizedSearch.h"
+#include "Feasibility.h"
+#include "Verify.h"
+#include "WarmStart.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+
+// Melhora mínima aceita: com λ real, empates por arredondamento não podem gerar ciclos
+constexpr double kMinGain = 1e-7;
+
+// predicted recebe a variação do objetivo penalizado prevista para o movimento aplicado
+using PenalizedStep = bool (*)(const Data&, Solution&, double, double&);
+
+long long ViolationOf(long long max_prefix, long long min_prefix, long long Q) {
+    return std::max(0LL, max_prefix - min_prefix - Q);
+}
+
+RouteLoadWindow StationWindow(long long demand) {
+    return {demand, std::max(0LL, demand), std::min(0LL, demand)};
+}
+
+// Violação após inserir um trecho de janela w antes de route.nodes[pos]
+long long InsertViolation(const RouteLoadProfile& profile, size_t pos, const RouteLoadWindow& w, long long Q) {
+    long long before = profile.prefix[pos - 1];
+    long long max_prefix = std::max({profile.pre_max[pos - 1], before + w.max_prefix, profile.suf_max[pos] + w.total});
+    long long min_prefix = std::min({profile.pre_min[pos - 1], before + w.min_prefix, profile.suf_min[pos] + w.total});
+    return ViolationOf(max_prefix, min_prefix, Q);
+}
+
+// Violação após somar delta aos prefixos de pos em diante (troca de estação em pos)
+long long ReplaceViolation(const RouteLoadProfile& profile, size_t pos, long long delta, long long Q) {
+    return ViolationOf(std::max(profile.pre_max[pos - 1], profile.suf_max[pos] + delta),
+                       std::min(profile.pre_min[pos - 1], profile.suf_min[pos] + delta), Q);
+}
+
+// Perfis e violações de todas as rotas no início de um passo
+void BuildProfiles(const Data& data, const Solution& solution, std::vector<RouteLoadProfile>& profiles,
+                   std::vector<long long>& violation) {
+    const long long Q = static_cast<long long>(data.getVehicleCapacity());
+    profiles.resize(solution.routes.size());
+    violation.resize(solution.routes.size());
+    for (size_t r = 0; r < solution.routes.size(); ++r) {
+        BuildLoadProfile(data, solution.routes[r], profiles[r]);
+        size_t k = profiles[r].prefix.size() - 1;
+        violation[r] = ViolationOf(profiles[r].pre_max[k], profiles[r].pre_min[k], Q);
+    }
+}
+
+bool PenalizedRelocateStep(const Data& data, Solution& solution, double lambda, double& predicted) {
+    const long long Q = static_cast<long long>(data.getVehicleCapacity());
+    std::vector<RouteLoadProfile> profiles;
+    std::vector<long long> violation;
+    BuildProfiles(data, solution, profiles, violation);
+    RouteLoadProfile reduced_profile;
+
+    for (size_t from_idx = 0; from_idx < solution.routes.size(); ++from_idx) {
+        Route& from_route = solution.routes[from_idx];
+        if (from_route.nodes.size() <= 2) continue;
+        const RouteLoadProfile& fp = profiles[from_idx];
+
+        for (size_t client_pos = 1; client_pos < from_route.nodes.size() - 1; ++client_pos) {
+            int a = from_route.nodes[client_pos - 1];
+            int client = from_route.nodes[client_pos];
+            int b = from_route.nodes[client_pos + 1];
+            long long demand = NodeDemand(data, client);
+            RouteLoadWindow w = StationWindow(demand);
+
+            double removal = data.getTravelCost(a, b) - data.getTravelCost(a, client) - data.getTravelCost(client, b);
+            long long from_violation = ViolationOf(std::max(fp.pre_max[client_pos - 1], fp.suf_max[client_pos + 1] - demand),
+                                                   std::min(fp.pre_min[client_pos - 1], fp.suf_min[client_pos + 1] - demand), Q);
+            double base = removal + lambda * static_cast<double>(from_violation - violation[from_idx]);
+
+            for (size_t to_idx = 0; to_idx < solution.routes.size(); ++to_idx) {
+                if (to_idx == from_idx) continue;
+                Route& to_route = solution.routes[to_idx];
+                const RouteLoadProfile& tp = profiles[to_idx];
+
+                for (size_t pos = 1; pos < to_route.nodes.size(); ++pos) {
+                    int p = to_route.nodes[pos - 1];
+                    int q = to_route.nodes[pos];
+                    double delta = base + data.getTravelCost(p, client) + data.getTravelCost(client, q) -
+                                   data.getTravelCost(p, q) +
+                                   lambda * static_cast<double>(InsertViolation(tp, pos, w, Q) - violation[to_idx]);
+                    if (delta < -kMinGain) {
+                        predicted = delta;
+                        from_route.nodes.erase(from_route.nodes.begin() + client_pos);
+                        to_route.nodes.insert(to_route.nodes.begin() + pos, client);
+                        solution.total_cost = SolutionCost(data, solution);
+                        return true;
+                    }
+                }
+            }
+
+            // Mesma rota: perfil da rota sem o cliente
+            Route reduced = from_route;
+            reduced.nodes.erase(reduced.nodes.begin() + client_pos);
+            BuildLoadProfile(data, reduced, reduced_profile);
+            for (size_t pos = 1; pos < reduced.nodes.size(); ++pos) {
+                if (pos == client_pos) continue;
+                int p = reduced.nodes[pos - 1];
+                int q = reduced.nodes[pos];
+                double delta = removal + data.getTravelCost(p, client) + data.getTravelCost(client, q) -
+                               data.getTravelCost(p, q) +
+                               lambda * static_cast<double>(InsertViolation(reduced_profile, pos, w, Q) - violation[from_idx]);
+                if (delta < -kMinGain) {
+                    predicted = delta;
+                    reduced.nodes.insert(reduced.nodes.begin() + pos, client);
+                    from_route = std::move(reduced);
+                    solution.total_cost = SolutionCost(data, solution);
+                    return true;
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+bool PenalizedSwapStep(const Data& data, Solution& solution, double lambda, double& predicted) {
+    const long long Q = static_cast<long long>(data.getVehicleCapacity());
+    std::vector<RouteLoadProfile> profiles;
+    std::vector<long long> violation;
+    BuildProfiles(data, solution, profiles, violation);
+
+    for (size_t r1 = 0; r1 < solution.routes.size(); ++r1) {
+        Route& route1 = solution.routes[r1];
+        if (route1.nodes.size() <= 2) continue;
+
+        for (size_t r2 = r1 + 1; r2 < solution.routes.size(); ++r2) {
+            Route& route2 = solution.routes[r2];
+            if (route2.nodes.size() <= 2) continue;
+
+            for (size_t pos1 = 1; pos1 < route1.nodes.size() - 1; ++pos1) {
+                int a1 = route1.nodes[pos1 - 1], u = route1.nodes[pos1], b1 = route1.nodes[pos1 + 1];
+                long long du = NodeDemand(data, u);
+
+                for (size_t pos2 = 1; pos2 < route2.nodes.size() - 1; ++pos2) {
+                    int a2 = route2.nodes[pos2 - 1], v = route2.nodes[pos2], b2 = route2.nodes[pos2 + 1];
+                    long long delta_load = NodeDemand(data, v) - du;
+
+                    double delta = data.getTravelCost(a1, v) + data.getTravelCost(v, b1) - data.getTravelCost(a1, u) -
+                                   data.getTravelCost(u, b1) + data.getTravelCost(a2, u) + data.getTravelCost(u, b2) -
+                                   data.getTravelCost(a2, v) - data.getTravelCost(v, b2);
+                    delta += lambda * static_cast<double>(ReplaceViolation(profiles[r1], pos1, delta_load, Q) - violation[r1] +
+                                                          ReplaceViolation(profiles[r2], pos2, -delta_load, Q) - violation[r2]);
+                    if (delta < -kMinGain) {
+                        predicted = delta;
+                        std::swap(route1.nodes[pos1], route2.nodes[pos2]);
+                        solution.total_cost = SolutionCost(data, solution);
+                        return true;
+                    }
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+bool PenalizedTwoOptStep(const Data& data, Solution& solution, double lambda, double& predicted) {
+    const long long Q = static_cast<long long>(data.getVehicleCapacity());
+    RouteLoadProfile profile;
+
+    for (Route& route : solution.routes) {
+        if (route.nodes.size() < 4) continue;
+        BuildLoadProfile(data, route, profile);
+        const std::vector<int>& nodes = route.nodes;
+        size_t k = nodes.size() - 2;
+        long long route_violation = ViolationOf(profile.pre_max[k], profile.pre_min[k], Q);
+
+        for (size_t i = 1; i < nodes.size() - 2; ++i) {
+            // Custo interno invertido e extremos de prefix[i-1..j-1] acumulados ao crescer j
+            double inner = 0.0;
+            long long run_min = profile.prefix[i - 1];
+            long long run_max = profile.prefix[i - 1];
+            for (size_t j = i + 1; j < nodes.size() - 1; ++j) {
+                inner += data.getTravelCost(nodes[j], nodes[j - 1]) - data.getTravelCost(nodes[j - 1], nodes[j]);
+                run_min = std::min(run_min, profile.prefix[j - 1]);
+                run_max = std::max(run_max, profile.prefix[j - 1]);
+
+                long long base = profile.prefix[i - 1] + profile.prefix[j];
+                long long max_prefix = std::max({profile.pre_max[i - 1], profile.suf_max[j + 1], base - run_min});
+                long long min_prefix = std::min({profile.pre_min[i - 1], profile.suf_min[j + 1], base - run_max});
+
+                int a = nodes[i - 1], b = nodes[j + 1];
+                double delta = data.getTravelCost(a, nodes[j]) + data.getTravelCost(nodes[i], b) -
+                               data.getTravelCost(a, nodes[i]) - data.getTravelCost(nodes[j], b) + inner +
+                               lambda * static_cast<double>(ViolationOf(max_prefix, min_prefix, Q) - route_violation);
+                if (delta < -kMinGain) {
+                    predicted = delta;
+                    std::reverse(route.nodes.begin() + i, route.nodes.begin() + j + 1);
+                    solution.total_cost = SolutionCost(data, solution);
+                    return true;
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+bool PenalizedOrOpt2Step(const Data& data, Solution& solution, double lambda, double& predicted) {
+    const long long Q = static_cast<long long>(data.getVehicleCapacity());
+    RouteLoadProfile profile;
+
+    for (Route& route : solution.routes) {
+        if (route.nodes.size() < 5) continue;
+        BuildLoadProfile(data, route, profile);
+        size_t k = route.nodes.size() - 2;
+        long long route_violation = ViolationOf(profile.pre_max[k], profile.pre_min[k], Q);
+
+        for (size_t start_pos = 1; start_pos < route.nodes.size() - 2; ++start_pos) {
+            int a = route.nodes[start_pos - 1];
+            int x = route.nodes[start_pos];
+            int y = route.nodes[start_pos + 1];
+            int b = route.nodes[start_pos + 2];
+            long long dx = NodeDemand(data, x);
+            RouteLoadWindow chain = ConcatWindows(StationWindow(dx), StationWindow(NodeDemand(data, y)));
+            double removal = data.getTravelCost(a, b) - data.getTravelCost(a, x) - data.getTravelCost(y, b);
+
+            Route reduced = route;
+            reduced.nodes.erase(reduced.nodes.begin() + start_pos, reduced.nodes.begin() + start_pos + 2);
+            RouteLoadProfile reduced_profile;
+            BuildLoadProfile(data, reduced, reduced_profile);
+
+            for (size_t insert_pos = 1; insert_pos < reduced.nodes.size(); ++insert_pos) {
+                if (insert_pos == start_pos) continue;
+                int p = reduced.nodes[insert_pos - 1];
+                int q = reduced.nodes[insert_pos];
+                double delta = removal + data.getTravelCost(p, x) + data.getTravelCost(y, q) - data.getTravelCost(p, q) +
+                               lambda * static_cast<double>(InsertViolation(reduced_profile, insert_pos, chain, Q) -
+                                                            route_violation);
+                if (delta < -kMinGain) {
+                    predicted = delta;
+                    reduced.nodes.insert(reduced.nodes.begin() + insert_pos, {x, y});
+                    route = std::move(reduced);
+                    solution.total_cost = SolutionCost(data, solution);
+                    return true;
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+} // namespace
+
+long long SolutionViolation(const Data& data, const Solution& solution) {
+    long long total = 0;
+    for (const Route& route : solution.routes) {
+        total += CheckRouteFeasible(data, route).cap_violation;
+    }
+    return total;
+}
+
+double PenalizedCost(const Data& data, const Solution& solution, double lambda) {
+    return SolutionCost(data, solution) + lambda * static_cast<double>(SolutionViolation(data, solution));
+}
+
+double InitialPenalty(const Data& data) {
+    const int n = data.getNumStations();
+    double max_cost = 0.0;
+    for (int i = 0; i <= n; ++i) {
+        for (int j = 0; j <= n; ++j) {
+            max_cost = std::max(max_cost, data.getTravelCost(i, j));
+        }
+    }
+    long long max_demand = 1;
+    for (int v = 1; v <= n; ++v) {
+        max_demand = std::max(max_demand, std::llabs(NodeDemand(data, v)));
+    }
+    return std::max(1e-3, max_cost / static_cast<double>(max_demand));
+}
+
+void AdaptivePenalty::record(bool feasible) {
+    window_feasible += feasible ? 1 : 0;
+    if (++window_count < kWindow) {
+        return;
+    }
+    double fraction = static_cast<double>(window_feasible) / window_count;
+    if (fraction < target - kTolerance) {
+        lambda = std::min(lambda * kIncrease, 1e12);
+    } else if (fraction > target + kTolerance) {
+        lambda = std::max(lambda * kDecrease, 1e-3);
+    }
+    window_feasible = 0;
+    window_count = 0;
+}
+
+Solution PenalizedRVND(const Data& data, const Solution& start, double lambda, std::mt19937& rng, RVNDStats* stats) {
+    static const PenalizedStep kSteps[] = {PenalizedRelocateStep, PenalizedSwapStep, PenalizedTwoOptStep,
+                                           PenalizedOrOpt2Step};
+    const auto& names = GetDefaultNeighborhoodNames();
+
+    std::vector<int> order(std::size(kSteps));
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = static_cast<int>(i);
+    }
+
+    Solution current_solution = start;
+    current_solution.total_cost = SolutionCost(data, current_solution);
+
+    std::shuffle(order.begin(), order.end(), rng);
+
+    int k = 0;
+    while (k < static_cast<int>(order.size())) {
+        const bool verify = VerifyNextMove();
+        const double before = verify ? PenalizedCost(data, current_solution, lambda) : 0.0;
+        double predicted = 0.0;
+        if (kSteps[order[k]](data, current_solution, lambda, predicted)) {
+            if (verify) {
+                VerifyMove(data, current_solution, names[order[k]].c_str(), before, predicted, lambda);
+            }
+            if (stats) {
+                stats->improvements++;
+                stats->last_improving = names[order[k]].c_str();
+            }
+            std::shuffle(order.begin(), order.end(), rng);
+            k = 0;
+        } else {
+            k++;
+        }
+    }
+
+    return current_solution;
+}
+
+bool ProjectToFeasible(const Data& data, Solution& solution, std::mt19937& rng, RVNDStats* stats) {
+    RepairStats repair;
+    Solution repaired = RepairSolution(data, solution, repair);
+    if (!repair.complete) {
+        return false;
+    }
+    solution = RVND(data, repaired, rng, stats);
+    return true;
+}
@@ -0,0 +1,45 @@
+#ifndef PENALIZED_SEARCH_H
+#define PENALIZED_SEARCH_H
+
+#include <random>
+#include "Construction.h"
+#include "Instance.h"
+#include "LocalSearch.h"
+
+// Busca com capacidade relaxada: rotas podem violar a janela de carga e o objetivo passa a
+// ser custo + λ·(soma de cap_violation das rotas). Os ótimos locais inviáveis são projetados
+// de volta na região viável antes de competir com o incumbente.
+
+[[nodiscard]] long long SolutionViolation(const Data& data, const Solution& solution);
+[[nodiscard]] double    PenalizedCost(const Data& data, const Solution& solution, double lambda);
+
+// λ inicial na escala do problema: maior custo de arco por unidade da maior |demanda|. O(n²)
+[[nodiscard]] double InitialPenalty(const Data& data);
+
+// Ajuste adaptativo de λ: a cada kWindow ótimos locais, λ sobe se a fração viável ficou
+// abaixo de `target` e desce se ficou acima (com folga de kTolerance em torno do alvo)
+struct AdaptivePenalty {
+    static constexpr int    kWindow    = 20;
+    static constexpr double kTolerance = 0.05;
+    static constexpr double kIncrease  = 1.2;
+    static constexpr double kDecrease  = 0.85;
+
+    double lambda = 1.0;
+    double target = 0.5;
+    int    window_feasible = 0;
+    int    window_count = 0;
+
+    void record(bool feasible);
+};
+
+// RVND com as vizinhanças padrão (relocate, swap, 2-opt, or-opt-2) sob o objetivo penalizado.
+// Movimentos entre rotas são avaliados em O(1) pelos perfis de carga. O resultado pode ser
+// inviável; total_cost é só o custo (sem penalidade).
+[[nodiscard]] Solution PenalizedRVND(const Data& data, const Solution& start, double lambda,
+                                     std::mt19937& rng, RVNDStats* stats = nullptr);
+
+// Projeção na região viável: RepairSolution (ejeção das estações que mais violam e
+// reinserção mais barata) seguido do RVND viável. false se alguma estação ficou de fora.
+bool ProjectToFeasible(const Data& data, Solution& solution, std::mt19937& rng, RVNDStats* stats = nullptr);
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef PROC_STATS_H
+#define PROC_STATS_H
+
+// Memória do processo a partir de /proc/self (Linux). Fora do Linux os valores são -1.
+
+#include <fstream>
+#include <string>
+
+// Valor em kB de um campo de /proc/self/status (ex.: "VmRSS", "VmHWM"), ou -1
+inline long ReadProcStatusKb(const std::string& key) {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, key.size(), key) == 0 && line.size() > key.size() && line[key.size()] == ':') {
+            return std::stol(line.substr(key.size() + 1));
+        }
+    }
+    return -1;
+}
+
+// Zera o pico de RSS (VmHWM) para medir fases isoladamente; false se o kernel não permitir
+inline bool ResetPeakRss() {
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    if (!clear_refs) {
+        return false;
+    }
+    clear_refs << "5";
+    return static_cast<bool>(clear_refs.flush());
+}
+
+#endif
@@ -0,0 +1,256 @@
+#include "Resequence.h"
+#include "Feasibility.h"
+#include "Rng.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// Teto de rótulos em toda a DP (memória); acima disso desiste e a rota fica com a heurística
+constexpr size_t kMaxLabels = size_t{1} << 22;
+
+struct Label {
+    double    cost;
+    long long hi;      // maior prefixo até aqui (inclui 0)
+    long long lo;      // menor prefixo até aqui (inclui 0)
+    int       last;    // índice da última estação
+    int       parent;  // rótulo anterior no pool (-1 no primeiro)
+};
+
+double RouteCostOf(const Data& data, const std::vector<int>& stations) {
+    double cost = 0.0;
+    int prev = 0;
+    for (int v : stations) {
+        cost += data.getTravelCost(prev, v);
+        prev = v;
+    }
+    return cost + data.getTravelCost(prev, 0);
+}
+
+uint64_t HashStations(const std::vector<int>& sorted) {
+    uint64_t h = Mix64(sorted.size());
+    for (int v : sorted) {
+        h = Mix64(h ^ static_cast<uint64_t>(v));
+    }
+    return h;
+}
+
+} // namespace
+
+bool OptimalRouteOrder(const Data& data, const std::vector<int>& stations, std::vector<int>& order, double& cost,
+                       double upper_bound) {
+    const int k = static_cast<int>(stations.size());
+    if (k > kExactMaxStations) {
+        return false;
+    }
+    order.clear();
+    if (k == 0) {
+        cost = 0.0;
+        return true;
+    }
+
+    const long long Q = static_cast<long long>(data.getVehicleCapacity());
+    const uint32_t full = (1u << k) - 1;
+    std::vector<long long> demand(k);
+    for (int i = 0; i < k; ++i) {
+        demand[i] = NodeDemand(data, stations[i]);
+    }
+    std::vector<long long> load(size_t{1} << k, 0);
+    for (uint32_t mask = 1; mask <= full; ++mask) {
+        int low = __builtin_ctz(mask);
+        load[mask] = load[mask & (mask - 1)] + demand[low];
+    }
+
+    // Limitante inferior do que falta após visitar mask: cada estação fora de mask ainda recebe
+    // um arco (o mais barato vindo de outra estação) e a rota volta ao depósito
+    std::vector<double> min_in(k, std::numeric_limits<double>::infinity());
+    double min_return = std::numeric_limits<double>::infinity();
+    for (int v = 0; v < k; ++v) {
+        for (int u = 0; u < k; ++u) {
+            if (u != v) {
+                min_in[v] = std::min(min_in[v], data.getTravelCost(stations[u], stations[v]));
+            }
+        }
+        min_return = std::min(min_return, data.getTravelCost(stations[v], 0));
+    }
+    std::vector<double> remaining(size_t{1} << k, 0.0);
+    remaining[0] = min_return;
+    for (int v = 0; v < k; ++v) {
+        remaining[0] += k > 1 ? min_in[v] : 0.0;
+    }
+    for (uint32_t mask = 1; mask <= full; ++mask) {
+        int low = __builtin_ctz(mask);
+        remaining[mask] = remaining[mask & (mask - 1)] - (k > 1 ? min_in[low] : 0.0);
+    }
+
+    // Rótulos de (mask, j) contíguos no pool: pool[begin[cell] .. begin[cell] + count[cell])
+    std::vector<Label> pool;
+    std::vector<uint32_t> begin(static_cast<size_t>(full + 1) * k, 0);
+    std::vector<uint32_t> count(static_cast<size_t>(full + 1) * k, 0);
+    std::vector<Label> candidates;
+
+    for (uint32_t mask = 1; mask <= full; ++mask) {
+        for (int j = 0; j < k; ++j) {
+            if (!(mask & (1u << j))) continue;
+            uint32_t rest = mask ^ (1u << j);
+            long long prefix = load[mask];
+            double bound = upper_bound - remaining[mask];
+
+            candidates.clear();
+            if (rest == 0) {
+                long long hi = std::max(0LL, prefix), lo = std::min(0LL, prefix);
+                double start = data.getTravelCost(0, stations[j]);
+                if (hi - lo <= Q && start < bound) {
+                    candidates.push_back({start, hi, lo, j, -1});
+                }
+            } else {
+                for (int i = 0; i < k; ++i) {
+                    if (!(rest & (1u << i))) continue;
+                    size_t cell = static_cast<size_t>(rest) * k + i;
+                    double arc = data.getTravelCost(stations[i], stations[j]);
+                    for (uint32_t l = begin[cell]; l < begin[cell] + count[cell]; ++l) {
+                        const Label& from = pool[l];
+                        long long hi = std::max(from.hi, prefix), lo = std::min(from.lo, prefix);
+                        if (hi - lo <= Q && from.cost + arc < bound) {
+                            candidates.push_back({from.cost + arc, hi, lo, j, static_cast<int>(l)});
+                        }
+                    }
+                }
+            }
+
+            // Fronteira de Pareto: mais barato primeiro; fica quem nenhum mais barato domina
+            std::sort(candidates.begin(), candidates.end(), [](const Label& a, const Label& b) {
+                if (a.cost != b.cost) return a.cost < b.cost;
+                if (a.hi != b.hi) return a.hi < b.hi;
+                return a.lo > b.lo;
+            });
+            size_t cell = static_cast<size_t>(mask) * k + j;
+            begin[cell] = static_cast<uint32_t>(pool.size());
+            for (const Label& c : candidates) {
+                bool dominated = false;
+                for (uint32_t l = begin[cell]; l < pool.size() && !dominated; ++l) {
+                    dominated = pool[l].hi <= c.hi && pool[l].lo >= c.lo;
+                }
+                if (!dominated) {
+                    pool.push_back(c);
+                }
+            }
+            count[cell] = static_cast<uint32_t>(pool.size() - begin[cell]);
+            if (pool.size() > kMaxLabels) {
+                return false;
+            }
+        }
+    }
+
+    int best = -1;
+    cost = upper_bound;
+    for (int j = 0; j < k; ++j) {
+        size_t cell = static_cast<size_t>(full) * k + j;
+        double back = data.getTravelCost(stations[j], 0);
+        for (uint32_t l = begin[cell]; l < begin[cell] + count[cell]; ++l) {
+            if (pool[l].cost + back < cost) {
+                cost = pool[l].cost + back;
+                best = static_cast<int>(l);
+            }
+        }
+    }
+    if (best < 0) {
+        return true;
+    }
+
+    for (int l = best; l >= 0; l = pool[l].parent) {
+        order.push_back(stations[pool[l].last]);
+    }
+    std::reverse(order.begin(), order.end());
+    return true;
+}
+
+bool SequenceMemo::lookup(const Data& data, const std::vector<int>& stations, std::vector<int>& order, double& cost) {
+    std::vector<int> key = stations;
+    std::sort(key.begin(), key.end());
+    uint64_t hash = HashStations(key);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = entries.find(hash);
+        if (it != entries.end() && it->second.key == key) {
+            hit_count++;
+            order = it->second.order;
+            cost = it->second.cost;
+            return it->second.complete;
+        }
+        miss_count++;
+    }
+
+    // Fora do lock. A rota atual (viável) limita a DP um pouco acima do seu custo: a poda não
+    // alcança o ótimo, e a ordem devolvida é a mesma para qualquer rota com esse conjunto, então
+    // o memo não depende de qual thread o preencheu
+    Entry entry;
+    double current = RouteCostOf(data, stations);
+    double bound = current + 1e-9 * std::max(1.0, std::abs(current));
+    entry.complete = OptimalRouteOrder(data, key, entry.order, entry.cost, bound);
+    if (entry.order.empty()) {
+        entry.order = stations;
+        entry.cost = current;
+    }
+    order = entry.order;
+    cost = entry.cost;
+    bool complete = entry.complete;
+    entry.key = std::move(key);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (entries.size() >= capacity) {
+        entries.clear();
+    }
+    entries[hash] = std::move(entry);
+    return complete;
+}
+
+bool ResequenceStep(const Data& data, Solution& solution, SequenceMemo& memo, double& predicted,
+                    RouteOptimaCache* cache) {
+    bool improved = false;
+    double total_delta = 0.0;
+    std::vector<int> stations;
+    std::vector<int> order;
+
+    for (Route& route : solution.routes) {
+        int size = static_cast<int>(route.nodes.size()) - 2;
+        if (size < 2) continue;
+
+        if (size <= kExactMaxStations) {
+            stations.assign(route.nodes.begin() + 1, route.nodes.end() - 1);
+            double cost;
+            if (memo.lookup(data, stations, order, cost)) {
+                double current = RouteCost(data, route);
+                if (cost < current - 1e-9) {
+                    std::copy(order.begin(), order.end(), route.nodes.begin() + 1);
+                    total_delta += cost - current;
+                    improved = true;
+                }
+                continue;
+            }
+        }
+
+        // Rota longa (ou DP abandonada): ótimo local de 2-opt/Or-opt-2
+        double delta = 0.0;
+        if (cache) {
+            while (cache->improve(data, route, RouteOptimaCache::kTwoOpt, delta) ||
+                   cache->improve(data, route, RouteOptimaCache::kOrOpt2, delta)) {
+                total_delta += delta;
+                improved = true;
+            }
+        } else {
+            while (TwoOptRoute(data, route, delta) || OrOpt2Route(data, route, delta)) {
+                total_delta += delta;
+                improved = true;
+            }
+        }
+    }
+
+    if (improved) {
+        predicted = total_delta;
+        solution.total_cost = SolutionCost(data, solution);
+    }
+    return improved;
+}
@@ -0,0 +1,71 @@
+#ifndef RESEQUENCE_H
+#define RESEQUENCE_H
+
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include "Construction.h"
+#include "Instance.h"
+#include "LocalSearch.h"
+
+// Maior rota re-sequenciada de forma exata; acima disso vale 2-opt/Or-opt-2
+constexpr int kExactMaxStations = 12;
+
+// Ordem ótima das estações de uma rota sob a restrição de janela de carga: DP de Held–Karp
+// sobre (subconjunto, última estação) com rótulos Pareto (custo, maior prefixo, menor
+// prefixo), O(2^k·k²·rótulos). Rótulos com custo >= upper_bound são podados: `order` sai
+// vazia se nenhuma ordem viável custa menos que isso. false se a DP não pôde ser concluída
+// (conjunto ou número de rótulos grande demais).
+bool OptimalRouteOrder(const Data& data, const std::vector<int>& stations, std::vector<int>& order, double& cost,
+                       double upper_bound = std::numeric_limits<double>::infinity());
+
+// Memo das ordens ótimas por conjunto de estações (independe da ordem atual da rota), limitado
+// a `capacity` conjuntos: ao encher, é esvaziado. Seguro para uso entre threads.
+class SequenceMemo {
+public:
+    explicit SequenceMemo(size_t capacity = 1 << 16) : capacity(capacity) {}
+
+    // Ordem ótima da rota com as estações `stations`, na ordem atual (usada como limitante e
+    // como resposta se nada for melhor), calculada ou vinda do memo. false se a DP não concluiu.
+    bool lookup(const Data& data, const std::vector<int>& stations, std::vector<int>& order, double& cost);
+
+    [[nodiscard]] long long hits() const { return hit_count; }
+    [[nodiscard]] long long misses() const { return miss_count; }
+
+private:
+    struct Entry {
+        std::vector<int> key;  // estações ordenadas (confere colisões do hash)
+        std::vector<int> order;
+        double cost = 0.0;
+        bool complete = false;
+    };
+
+    size_t capacity;
+    std::mutex mutex;
+    std::unordered_map<uint64_t, Entry> entries;
+    long long hit_count = 0;
+    long long miss_count = 0;
+};
+
+// Vizinhança de intensificação: troca a sequência de cada rota de até kExactMaxStations
+// estações pela ótima (memoizada) e leva as maiores a um ótimo local de 2-opt/Or-opt-2
+// (pelo cache, se houver). Substitui TwoOptStep e OrOpt2Step no RVND.
+// `predicted`: soma das variações de custo das rotas (custo da DP ou deltas do 2-opt/Or-opt-2).
+bool ResequenceStep(const Data& data, Solution& solution, SequenceMemo& memo, double& predicted,
+                    RouteOptimaCache* cache = nullptr);
+
+struct ResequenceNeighborhood {
+    static constexpr const char* kName = "resequence";
+    SequenceMemo& memo;
+    RouteOptimaCache* cache;
+    bool operator()(const Data& data, Solution& solution, std::mt19937&, double& predicted) const {
+        return ResequenceStep(data, solution, memo, predicted, cache);
+    }
+};
+
+using ResequencePipeline = NeighborhoodPipeline<RelocateNeighborhood, SwapNeighborhood, ResequenceNeighborhood>;
+
+#endif
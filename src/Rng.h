@@ -0,0 +1,38 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <cstdint>
+#include <random>
+
+// Fluxos de números aleatórios derivados de uma semente. A semente de cada fluxo é função
+// pura de (seed, stream): não depende da ordem em que os fluxos são criados nem de quantas
+// threads os consomem, o que torna execuções paralelas reproduzíveis bit a bit.
+
+constexpr uint64_t kGoldenGamma = 0x9E3779B97F4A7C15ULL;
+
+// Finalizador do SplitMix64 (bijeção em 64 bits com boa avalanche)
+inline uint64_t Mix64(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// SplitMix64: avança o estado e devolve o próximo valor
+inline uint64_t SplitMix64(uint64_t& state) {
+    return Mix64(state += kGoldenGamma);
+}
+
+// Semente do fluxo `stream` da semente `seed` (gerador baseado em contador)
+inline uint64_t StreamSeed(uint64_t seed, uint64_t stream) {
+    return Mix64(Mix64(seed + kGoldenGamma) ^ Mix64(stream + 2 * kGoldenGamma));
+}
+
+// mt19937 do fluxo `stream`; seed_seq tem algoritmo especificado, então o estado inicial
+// é o mesmo em qualquer plataforma
+inline std::mt19937 MakeStreamRng(uint64_t seed, uint64_t stream) {
+    uint64_t s = StreamSeed(seed, stream);
+    std::seed_seq seq{static_cast<uint32_t>(s), static_cast<uint32_t>(s >> 32)};
+    return std::mt19937(seq);
+}
+
+#endif
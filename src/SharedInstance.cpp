@@ -0,0 +1,226 @@
+#include "SharedInstance.h"
+#include "Rng.h"
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr uint64_t kSegmentMagic = 0x314d48534b424a50ULL;  // "PJBKSHM1"
+
+// Espera máxima pelo processo que está preenchendo o segmento
+constexpr auto kAttachTimeout = std::chrono::seconds(60);
+constexpr auto kPollInterval = std::chrono::milliseconds(1);
+// Tentativas de abrir quando o segmento some ou está sendo removido entre duas chamadas
+constexpr int kOpenRetries = 100;
+
+enum : uint32_t { kFilling = 0, kReady = 1, kFailed = 2 };
+
+size_t AlignUp(size_t bytes) {
+    return (bytes + 63) & ~size_t{63};
+}
+
+} // namespace
+
+// Início do segmento (zerado pelo ftruncate: state começa em kFilling)
+struct SharedInstance::Header {
+    std::atomic<uint32_t> state;
+    std::atomic<int32_t>  refs;
+    uint64_t magic;
+    int32_t  n;
+    int32_t  m;
+    int32_t  Q;
+    int32_t  creator_pid;
+};
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<int32_t>::is_always_lock_free,
+              "contadores do segmento precisam ser atômicos entre processos");
+
+namespace {
+
+size_t DemandsOffset() {
+    return AlignUp(sizeof(uint64_t) * 4);
+}
+
+size_t MatrixOffset(int n) {
+    return AlignUp(DemandsOffset() + sizeof(long long) * static_cast<size_t>(n));
+}
+
+} // namespace
+
+std::string SharedInstance::SegmentName(const std::string& path) {
+    char* absolute = realpath(path.c_str(), nullptr);
+    if (absolute == nullptr) {
+        return "";
+    }
+    std::string canonical(absolute);
+    free(absolute);
+
+    struct stat st;
+    if (stat(canonical.c_str(), &st) != 0) {
+        return "";
+    }
+
+    uint64_t h = Mix64(canonical.size());
+    for (unsigned char c : canonical) {
+        h = Mix64(h ^ c);
+    }
+    h = Mix64(h ^ static_cast<uint64_t>(st.st_size));
+    h = Mix64(h ^ static_cast<uint64_t>(st.st_mtim.tv_sec));
+    h = Mix64(h ^ static_cast<uint64_t>(st.st_mtim.tv_nsec));
+
+    char name[32];
+    snprintf(name, sizeof(name), "/jpbike-%016llx", static_cast<unsigned long long>(h));
+    return name;
+}
+
+std::unique_ptr<SharedInstance> SharedInstance::open(const std::string& name, bool& created) {
+    static_assert(sizeof(Header) <= sizeof(uint64_t) * 4, "cabeçalho maior que o reservado");
+
+    for (int attempt = 0; attempt < kOpenRetries; ++attempt) {
+        int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (fd >= 0) {
+            created = true;
+            return std::unique_ptr<SharedInstance>(new SharedInstance(name, fd, true));
+        }
+        if (errno != EEXIST) {
+            return nullptr;
+        }
+
+        fd = shm_open(name.c_str(), O_RDWR, 0);
+        if (fd < 0) {
+            if (errno == ENOENT) continue;  // removido entre as duas chamadas
+            return nullptr;
+        }
+        std::unique_ptr<SharedInstance> segment(new SharedInstance(name, fd, false));
+
+        // O criador dimensiona o segmento de uma vez e só depois o preenche
+        auto deadline = std::chrono::steady_clock::now() + kAttachTimeout;
+        struct stat st;
+        while (fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) < sizeof(Header)) {
+            if (std::chrono::steady_clock::now() > deadline) return nullptr;
+            std::this_thread::sleep_for(kPollInterval);
+        }
+        if (static_cast<size_t>(st.st_size) < sizeof(Header) || !segment->map(static_cast<size_t>(st.st_size))) {
+            return nullptr;
+        }
+
+        Header* header = static_cast<Header*>(segment->base);
+        uint32_t state;
+        while ((state = header->state.load(std::memory_order_acquire)) == kFilling) {
+            // Criador que morreu no meio (erro de leitura sai com exit): o segmento nunca fica pronto
+            pid_t owner = header->creator_pid;
+            if (owner > 0 && kill(owner, 0) != 0 && errno == ESRCH) {
+                shm_unlink(name.c_str());
+                state = kFailed;
+                break;
+            }
+            if (std::chrono::steady_clock::now() > deadline) return nullptr;
+            std::this_thread::sleep_for(kPollInterval);
+        }
+        if (state == kFailed) {
+            continue;  // o criador desistiu e o nome foi removido
+        }
+
+        // Referência só enquanto o segmento está vivo: 0 quer dizer que o último dono está
+        // removendo o nome, e a próxima tentativa cria outro
+        int32_t refs = header->refs.load();
+        while (refs > 0 && !header->refs.compare_exchange_weak(refs, refs + 1)) {
+        }
+        if (refs <= 0) {
+            segment.reset();
+            std::this_thread::sleep_for(kPollInterval);
+            continue;
+        }
+        segment->published = true;
+        if (header->magic != kSegmentMagic ||
+            static_cast<size_t>(st.st_size) < MatrixOffset(header->n) +
+                                                  sizeof(double) * static_cast<size_t>(header->n + 1) * (header->n + 1)) {
+            return nullptr;
+        }
+        created = false;
+        return segment;
+    }
+    return nullptr;
+}
+
+SharedInstance::~SharedInstance() {
+    if (creator && !published) {
+        // Desistência do criador: acorda quem espera e libera o nome para outra tentativa
+        if (base == nullptr && ftruncate(fd, static_cast<off_t>(sizeof(Header))) == 0) {
+            map(sizeof(Header));
+        }
+        if (base != nullptr) {
+            static_cast<Header*>(base)->state.store(kFailed, std::memory_order_release);
+        }
+        shm_unlink(name.c_str());
+    } else if (published && base != nullptr) {
+        if (static_cast<Header*>(base)->refs.fetch_sub(1) == 1) {
+            shm_unlink(name.c_str());
+        }
+    }
+    if (base != nullptr) {
+        munmap(base, size);
+    }
+    close(fd);
+}
+
+bool SharedInstance::map(size_t bytes) {
+    void* mapped = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapped == MAP_FAILED) {
+        return false;
+    }
+    base = mapped;
+    size = bytes;
+    return true;
+}
+
+bool SharedInstance::allocate(int n, int m, int Q) {
+    size_t bytes = MatrixOffset(n) + sizeof(double) * static_cast<size_t>(n + 1) * static_cast<size_t>(n + 1);
+    if (!creator || base != nullptr || ftruncate(fd, static_cast<off_t>(bytes)) != 0 || !map(bytes)) {
+        return false;
+    }
+    Header* header = static_cast<Header*>(base);
+    header->magic = kSegmentMagic;
+    header->n = n;
+    header->m = m;
+    header->Q = Q;
+    header->creator_pid = static_cast<int32_t>(getpid());
+    return true;
+}
+
+void SharedInstance::publish() {
+    Header* header = static_cast<Header*>(base);
+    header->refs.store(1);
+    header->state.store(kReady, std::memory_order_release);
+    published = true;
+}
+
+int SharedInstance::stations() const {
+    return static_cast<const Header*>(base)->n;
+}
+
+int SharedInstance::vehicles() const {
+    return static_cast<const Header*>(base)->m;
+}
+
+int SharedInstance::capacity() const {
+    return static_cast<const Header*>(base)->Q;
+}
+
+long long* SharedInstance::demands() const {
+    return reinterpret_cast<long long*>(static_cast<char*>(base) + DemandsOffset());
+}
+
+double* SharedInstance::matrix() const {
+    return reinterpret_cast<double*>(static_cast<char*>(base) + MatrixOffset(stations()));
+}
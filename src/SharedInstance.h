@@ -0,0 +1,53 @@
+#ifndef SHARED_INSTANCE_H
+#define SHARED_INSTANCE_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+// Instância (demandas e matriz de custos) num segmento POSIX de memória compartilhada, para que
+// vários processos resolvendo a mesma instância usem uma única cópia da matriz. O segmento é
+// nomeado pelo arquivo de origem (caminho absoluto, tamanho e mtime): o primeiro processo o
+// cria e preenche, os seguintes só o anexam, sem ler o arquivo. Cada processo anexado conta
+// uma referência no próprio segmento; o último a soltar remove o nome (shm_unlink). Um processo
+// que morre sem soltar deixa o segmento em /dev/shm até ser removido à mão.
+class SharedInstance {
+public:
+    // Nome do segmento da instância em `path`; vazio se o arquivo não existe
+    static std::string SegmentName(const std::string& path);
+
+    // Anexa ao segmento pronto `name` ou, se ele não existe, o cria com exclusividade
+    // (created = true: o chamador dimensiona com allocate(), preenche e chama publish()).
+    // nullptr se não foi possível (sem suporte, permissão ou criador que não terminou a tempo).
+    static std::unique_ptr<SharedInstance> open(const std::string& name, bool& created);
+
+    ~SharedInstance();
+    SharedInstance(const SharedInstance&) = delete;
+    SharedInstance& operator=(const SharedInstance&) = delete;
+
+    // Criador: dimensiona o segmento para n estações. false em erro
+    bool allocate(int n, int m, int Q);
+    // Criador: demandas e matriz preenchidas; libera os processos à espera
+    void publish();
+
+    [[nodiscard]] int stations() const;
+    [[nodiscard]] int vehicles() const;
+    [[nodiscard]] int capacity() const;
+    [[nodiscard]] long long* demands() const;
+    [[nodiscard]] double* matrix() const;  // (n+1) x (n+1), linha a linha
+
+private:
+    struct Header;
+
+    SharedInstance(std::string name, int fd, bool creator) : name(std::move(name)), fd(fd), creator(creator) {}
+    bool map(size_t bytes);
+
+    std::string name;
+    int    fd;
+    bool   creator;
+    bool   published = false;
+    void*  base = nullptr;
+    size_t size = 0;
+};
+
+#endif
@@ -0,0 +1,209 @@
+#include "Solver.h"
+#include "Aggregation.h"
+#include "Decomposition.h"
+#include "Feasibility.h"
+#include "LocalSearch.h"
+#include "Locality.h"
+#include "Trace.h"
+#include "WarmStart.h"
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+
+using namespace std;
+
+namespace {
+
+Solution Construct(const Data& data, const string& method, mt19937& rng, bool verbose) {
+    if (method == "insertion") {
+        if (verbose) cout << "Aplicando algoritmo Greedy Best-Insertion..." << endl;
+        return GreedyBestInsertion(data, rng);
+    }
+    if (method == "savings") {
+        if (verbose) cout << "Aplicando algoritmo Clarke-Wright (economias)..." << endl;
+        return ClarkeWrightSavings(data, rng);
+    }
+    if (verbose) cout << "Aplicando algoritmo Greedy Nearest-Feasible..." << endl;
+    return GreedyNearestFeasible(data, rng);
+}
+
+} // namespace
+
+SolveResult Solve(const Data& data, const SolverOptions& options, bool verbose) {
+    auto start_time = chrono::steady_clock::now();
+    auto seconds = [&start_time]() {
+        return chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+    };
+    TraceSink* trace = options.ils.trace;
+    mt19937 rng(options.seed);
+    SolveResult result;
+
+    // Renumeração por localidade numa cópia (a matriz de `data` é só lida): a busca usa os ids
+    // internos de `work`, e a solução volta para os de `data` no fim
+    const Data* work = &data;
+    unique_ptr<Data> renumbered;
+    if (options.renumber) {
+        PhaseTimer timer(trace, "renumber");
+        const vector<long long> demands = data.getAllDemands();
+        renumbered = make_unique<Data>(data.getInstanceName(), data.getNumStations(), data.getNumVehicles(),
+                                       data.getVehicleCapacity(), demands.data(), data.getCostData());
+        renumbered->renumber(LocalityOrder(*renumbered));
+        work = renumbered.get();
+        if (verbose) {
+            cout << "\nEstações renumeradas por localidade (cadeia do vizinho mais próximo)" << endl;
+        }
+    }
+
+    // Agregação de estações quase coincidentes: a busca roda na instância reduzida e a solução
+    // é expandida antes do VND
+    const Data* target = work;
+    Aggregation aggregation;
+    if (options.aggregate) {
+        PhaseTimer timer(trace, "aggregate");
+        aggregation = AggregateStations(*work, options.aggregate_threshold);
+        if (aggregation.reduced) {
+            target = aggregation.reduced.get();
+        }
+        if (verbose) {
+            cout << "\nAgregação (limiar " << options.aggregate_threshold << "): " << work->getNumStations() << " -> "
+                 << target->getNumStations() << " estações" << endl;
+        }
+        if (trace) {
+            trace->addCounter("aggregated_stations", static_cast<double>(target->getNumStations()));
+        }
+    }
+    result.solved_stations = target->getNumStations();
+
+    // Warm start: solução anterior reparada para as demandas atuais
+    Solution warm_solution;
+    if (options.warm_start) {
+        PhaseTimer timer(trace, "warm_start");
+        Solution internal = ToInternalIds(*work, *options.warm_start);
+        if (aggregation.reduced) {
+            internal = ContractSolution(aggregation, internal);
+        }
+        RepairStats repair;
+        warm_solution = RepairSolution(*target, internal, repair);
+        result.warm_started = repair.complete;
+
+        if (verbose) {
+            cout << "\n=== Warm Start ===" << endl;
+            cout << "Solução anterior: custo " << options.warm_start->total_cost << endl;
+            cout << "Rotas reparadas: " << repair.routes_repaired << ", estações ejetadas: " << repair.ejected
+                 << ", ausentes: " << repair.missing << ", novas rotas: " << repair.new_routes << endl;
+            cout << "Custo após reparo: " << warm_solution.total_cost << endl;
+        }
+        if (verbose && !result.warm_started) {
+            cout << "Aviso: reparo do warm start incompleto; construindo solução do zero." << endl;
+        }
+    }
+
+    ILSParams ils_params = options.ils;
+    if (options.on_progress) {
+        ils_params.on_improvement = [&options, &seconds](const Solution& best) {
+            if (options.ils.on_improvement) options.ils.on_improvement(best);
+            options.on_progress(best.total_cost, seconds());
+        };
+    }
+
+    Solution solution;
+    if (options.use_ils) {
+        if (options.decompose) {
+            Solution start;
+            if (result.warm_started) {
+                start = warm_solution;
+            } else {
+                PhaseTimer timer(trace, "construction");
+                start = Construct(*target, options.constructive, rng, false);
+            }
+            if (verbose) {
+                cout << "\n=== Decomposição (subproblemas de até " << options.decompose_size << " estações) ===" << endl;
+                cout << "Custo inicial (" << (result.warm_started ? "warm-start" : options.constructive)
+                     << "): " << start.total_cost << endl;
+            }
+
+            DecompositionParams decomposition_params;
+            decomposition_params.max_stations = options.decompose_size;
+            decomposition_params.batch = ils_params.batch;
+            decomposition_params.threads = max(1, ils_params.threads);
+            decomposition_params.time_limit = ils_params.time_limit;
+            decomposition_params.ils = ils_params;
+            solution = Decompose(*target, start, rng, decomposition_params, verbose);
+        } else {
+            solution = ILS(*target, rng, ils_params, verbose, result.warm_started ? &warm_solution : nullptr);
+        }
+    } else if (result.warm_started) {
+        solution = warm_solution;
+    } else {
+        PhaseTimer timer(trace, "construction");
+        if (verbose) {
+            cout << "\n=== Executando Heurística Construtiva ===" << endl;
+        }
+        solution = Construct(*target, options.constructive, rng, verbose);
+    }
+
+    if (aggregation.reduced) {
+        solution = ExpandSolution(*work, aggregation, solution);
+    }
+    if (!options.use_ils && options.on_progress) {
+        options.on_progress(solution.total_cost, seconds());
+    }
+
+    // VND após o construtivo (ou warm start), mantido só se continuar viável
+    Solution final_solution = solution;
+    if (options.use_vnd && !options.use_ils) {
+        if (verbose) {
+            cout << "\n=== VND (Variable Neighborhood Descent) ===" << endl;
+            cout << "Custo inicial: " << solution.total_cost << endl;
+        }
+
+        auto vnd_start = chrono::high_resolution_clock::now();
+        {
+            PhaseTimer timer(trace, "vnd");
+            final_solution = options.ils.or_opt_max > 0
+                                 ? VNDWith(*work, solution, rng,
+                                           OrOptPipeline(RelocateNeighborhood{}, SwapNeighborhood{}, TwoOptNeighborhood{},
+                                                         OrOptNeighborhood{options.ils.or_opt_max}))
+                                 : VND(*work, solution, rng);
+        }
+        auto vnd_duration = chrono::duration_cast<chrono::milliseconds>(chrono::high_resolution_clock::now() - vnd_start);
+
+        if (verbose) {
+            cout << "Custo final após VND: " << final_solution.total_cost << endl;
+            cout << "Melhoria: " << (solution.total_cost - final_solution.total_cost) << endl;
+            cout << "Tempo VND: " << vnd_duration.count() << " ms" << endl;
+        }
+
+        if (!CheckSolutionFeasible(*work, final_solution.routes)) {
+            if (verbose) {
+                cout << "ATENÇÃO: VND produziu solução inviável! Usando apenas a solução construtiva." << endl;
+            }
+            final_solution = solution;
+        } else if (options.on_progress && final_solution.total_cost < solution.total_cost) {
+            options.on_progress(final_solution.total_cost, seconds());
+        }
+    }
+
+    if (renumbered) {
+        solution = ToOriginalIds(*work, solution);
+        final_solution = ToOriginalIds(*work, final_solution);
+    }
+    result.constructed = std::move(solution);
+    result.solution = std::move(final_solution);
+    result.feasible = CheckSolutionFeasible(data, result.solution.routes);
+    const int unrouted = UnroutedStations(data, result.solution);
+    const int vehicles = data.getNumVehicles();
+    const int routes = static_cast<int>(result.solution.routes.size());
+    if (unrouted > 0) {
+        result.warning = to_string(unrouted) + " estações sem rota: " + to_string(vehicles) +
+                         " veículos não bastam para atender todas";
+    } else if (routes > vehicles) {
+        result.warning = to_string(routes) + " rotas para " + to_string(vehicles) + " veículos";
+    }
+    if (verbose && !result.warning.empty()) {
+        cout << "Aviso: " << result.warning << endl;
+    }
+    result.cancelled = options.ils.cancel && options.ils.cancel->load();
+    return result;
+}
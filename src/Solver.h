@@ -0,0 +1,45 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <functional>
+#include <string>
+#include "Construction.h"
+#include "ILS.h"
+#include "Instance.h"
+
+// Fluxo completo de resolução de uma instância já em memória, compartilhado pelo executável,
+// pelo daemon e pela biblioteca (libjpbike, API C em JPBike.h): renumeração, agregação, warm
+// start, ILS / decomposição / construtivo + VND e volta da solução para os ids de `data`.
+// `data` não é alterado: a renumeração trabalha numa cópia privada.
+struct SolverOptions {
+    unsigned int seed = 42;
+    bool        use_ils = false;
+    std::string constructive = "nearest";  // "nearest", "insertion" ou "savings" (também o início da decomposição)
+    bool        use_vnd = true;            // VND após o construtivo (sem ILS); descartado se inviável
+    bool        decompose = false;         // ILS por subproblemas de rotas próximas (exige use_ils)
+    int         decompose_size = 100;
+    bool        renumber = false;          // renumeração por localidade antes de resolver
+    bool        aggregate = false;         // agregação de estações quase coincidentes
+    double      aggregate_threshold = 0.0;
+    const Solution* warm_start = nullptr;  // solução anterior (ids de `data`), reparada para as demandas atuais
+
+    // Parâmetros do ILS, incluindo time_limit, threads, trace, on_improvement e cancel
+    ILSParams ils;
+
+    // A cada nova melhor solução: custo e segundos desde o início de Solve
+    std::function<void(double cost, double seconds)> on_progress;
+};
+
+struct SolveResult {
+    Solution constructed;         // saída do método (ILS, decomposição, construtivo ou warm start), antes do VND
+    Solution solution;            // solução final, ids de `data`
+    bool     feasible = false;    // solution passa em CheckSolutionFeasible
+    bool     warm_started = false;  // o warm start foi reparado por completo e usado
+    bool     cancelled = false;     // ils.cancel foi acionado durante a busca
+    int      solved_stations = 0;   // estações da instância efetivamente resolvida (após a agregação)
+    std::string warning;            // frota insuficiente (estações sem rota ou rotas além de m); vazio se não há
+};
+
+[[nodiscard]] SolveResult Solve(const Data& data, const SolverOptions& options, bool verbose);
+
+#endif
@@ -0,0 +1,133 @@
+#include "Trace.h"
+#include "ProcStats.h"
+#include <cstdio>
+#include <ctime>
+
+namespace {
+
+constexpr size_t kFlushThreshold = 1 << 20;
+
+std::string JsonString(const std::string& value) {
+    std::string escaped = "\"";
+    for (char c : value) {
+        switch (c) {
+            case '"':  escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\t': escaped += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buf[8];
+                    std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                    escaped += buf;
+                } else {
+                    escaped += c;
+                }
+        }
+    }
+    return escaped + "\"";
+}
+
+std::string JsonNumber(double value) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.10g", value);
+    return buf;
+}
+
+} // namespace
+
+TraceSink::TraceSink(const std::string& path) : out(path), start(std::chrono::steady_clock::now()) {
+    buffer.reserve(kFlushThreshold);
+}
+
+TraceSink::~TraceSink() {
+    finish();
+}
+
+double TraceSink::elapsed() const {
+    std::chrono::duration<double> d = std::chrono::steady_clock::now() - start;
+    return d.count();
+}
+
+void TraceSink::run(const std::string& instance, unsigned int seed, const std::string& method,
+                    const std::map<std::string, double>& params) {
+    std::string line = "{\"type\":\"run\",\"instance\":" + JsonString(instance) + ",\"seed\":" + std::to_string(seed) +
+                       ",\"method\":" + JsonString(method) + ",\"started_at\":" + std::to_string(std::time(nullptr));
+    for (const auto& [key, value] : params) {
+        line += ',';
+        line += JsonString(key);
+        line += ':';
+        line += JsonNumber(value);
+    }
+    append(line + "}");
+}
+
+void TraceSink::improvement(long long iter, int restart, double alpha, const std::string& op, double cost) {
+    append("{\"type\":\"improvement\",\"t\":" + JsonNumber(elapsed()) + ",\"iter\":" + std::to_string(iter) +
+           ",\"restart\":" + std::to_string(restart) + ",\"alpha\":" + JsonNumber(alpha) +
+           ",\"operator\":" + JsonString(op) + ",\"cost\":" + JsonNumber(cost) + "}");
+}
+
+void TraceSink::iteration(int iter, const AllocCounts& counts, long peak_rss_kb) {
+    append("{\"type\":\"iteration\",\"iter\":" + std::to_string(iter) +
+           ",\"allocations\":" + std::to_string(counts.allocations) + ",\"bytes\":" + std::to_string(counts.bytes) +
+           ",\"peak_rss_kb\":" + std::to_string(peak_rss_kb) + "}");
+}
+
+void TraceSink::finish() {
+    if (finished) {
+        return;
+    }
+    finished = true;
+
+    std::string line = "{\"type\":\"phases\",\"total\":" + JsonNumber(elapsed());
+    for (const auto& [phase, seconds] : phase_totals) {
+        line += ',';
+        line += JsonString(phase);
+        line += ':';
+        line += JsonNumber(seconds);
+    }
+    append(line + "}");
+
+    if (!counter_totals.empty()) {
+        line = "{\"type\":\"counters\"";
+        for (const auto& [name, value] : counter_totals) {
+            line += ',';
+            line += JsonString(name);
+            line += ':';
+            line += JsonNumber(value);
+        }
+        append(line + "}");
+    }
+
+    if (kAllocStatsEnabled) {
+        auto counts = [](const AllocCounts& c) {
+            return "{\"count\":" + std::to_string(c.allocations) + ",\"bytes\":" + std::to_string(c.bytes) + "}";
+        };
+        line = "{\"type\":\"allocations\",\"total\":" + counts(ProcessAllocCounts());
+        for (const auto& [phase, allocated] : phase_allocations) {
+            line += ',';
+            line += JsonString(phase);
+            line += ':';
+            line += counts(allocated);
+        }
+        append(line + ",\"peak_rss_kb\":" + std::to_string(ReadProcStatusKb("VmHWM")) + "}");
+    }
+    flush();
+}
+
+void TraceSink::flush() {
+    if (!buffer.empty()) {
+        out << buffer;
+        out.flush();
+        buffer.clear();
+    }
+}
+
+void TraceSink::append(const std::string& line) {
+    buffer += line;
+    buffer += '\n';
+    if (buffer.size() >= kFlushThreshold) {
+        flush();
+    }
+}
@@ -0,0 +1,103 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include "AllocStats.h"
+
+// Registro de convergência em JSON lines. Os eventos são formatados num buffer em memória
+// e só vão para o arquivo quando o buffer enche ou em flush(), fora do laço do ILS.
+//
+//   {"type":"run", ...}                      parâmetros da execução
+//   {"type":"improvement","t":..,"iter":..,"restart":..,"alpha":..,"operator":"..","cost":..}
+//   {"type":"phases","construction":..,"rvnd":..,"perturbation":..,"io":..}   segundos por fase
+//   {"type":"counters",...}                  contadores somados durante a execução (se houver)
+//
+// Compilado com JPBIKE_ALLOC_STATS (AllocStats.h), também:
+//   {"type":"iteration","iter":..,"allocations":..,"bytes":..,"peak_rss_kb":..}   por iteração do ILS
+//   {"type":"allocations","total":{"count":..,"bytes":..},"<fase>":{..},...,"peak_rss_kb":..}
+class TraceSink {
+public:
+    explicit TraceSink(const std::string& path);
+    ~TraceSink();
+
+    TraceSink(const TraceSink&) = delete;
+    TraceSink& operator=(const TraceSink&) = delete;
+
+    [[nodiscard]] bool ok() const { return static_cast<bool>(out); }
+
+    // Segundos desde a criação do sink
+    [[nodiscard]] double elapsed() const;
+
+    void run(const std::string& instance, unsigned int seed, const std::string& method,
+             const std::map<std::string, double>& params);
+    void improvement(long long iter, int restart, double alpha, const std::string& op, double cost);
+
+    // Pode ser chamado de várias threads (no modo paralelo os tempos são somados entre threads)
+    void addPhaseTime(const std::string& phase, double seconds) {
+        std::lock_guard<std::mutex> lock(mutex);
+        phase_totals[phase] += seconds;
+    }
+    [[nodiscard]] const std::map<std::string, double>& phases() const { return phase_totals; }
+
+    void addCounter(const std::string& name, double value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        counter_totals[name] += value;
+    }
+
+    void addPhaseAllocations(const std::string& phase, const AllocCounts& counts) {
+        std::lock_guard<std::mutex> lock(mutex);
+        phase_allocations[phase] += counts;
+    }
+    // Alocações de uma iteração do ILS e o pico de RSS até ela
+    void iteration(int iter, const AllocCounts& counts, long peak_rss_kb);
+
+    // Grava os totais por fase e os contadores e esvazia o buffer
+    void finish();
+    void flush();
+
+private:
+    void append(const std::string& line);
+
+    std::ofstream out;
+    std::string buffer;
+    std::chrono::steady_clock::time_point start;
+    std::map<std::string, double> phase_totals;
+    std::map<std::string, double> counter_totals;
+    std::map<std::string, AllocCounts> phase_allocations;
+    std::mutex mutex;
+    bool finished = false;
+};
+
+// Cronômetro de fase: soma a duração do escopo em sink->addPhaseTime (nada se sink == nullptr)
+// e, com JPBIKE_ALLOC_STATS, as alocações da thread no escopo em sink->addPhaseAllocations
+class PhaseTimer {
+public:
+    PhaseTimer(TraceSink* sink, const char* phase)
+        : sink(sink), phase(phase), begin(sink ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{}),
+          alloc_begin(sink && kAllocStatsEnabled ? ThreadAllocCounts() : AllocCounts{}) {}
+    ~PhaseTimer() {
+        if (sink) {
+            AllocCounts allocated = kAllocStatsEnabled ? ThreadAllocCounts() - alloc_begin : AllocCounts{};
+            std::chrono::duration<double> d = std::chrono::steady_clock::now() - begin;
+            sink->addPhaseTime(phase, d.count());
+            if (kAllocStatsEnabled) {
+                sink->addPhaseAllocations(phase, allocated);
+            }
+        }
+    }
+
+    PhaseTimer(const PhaseTimer&) = delete;
+    PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+private:
+    TraceSink* sink;
+    const char* phase;
+    std::chrono::steady_clock::time_point begin;
+    AllocCounts alloc_begin;
+};
+
+#endif
@@ -0,0 +1,106 @@
+#include "Verify.h"
+#include "Feasibility.h"
+#include "PenalizedSearch.h"
+#include "Rng.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace verify_detail {
+double probability = 0.0;
+} // namespace verify_detail
+
+namespace {
+
+unsigned int run_seed = 0;
+std::string run_command;
+std::atomic<long long> verified{0};
+
+struct Context {
+    long long restart = 0;
+    long long search = 0;
+};
+thread_local Context context;
+
+std::mt19937& SamplingRng() {
+    thread_local std::mt19937 rng =
+        MakeStreamRng(run_seed, static_cast<uint64_t>(std::hash<std::thread::id>{}(std::this_thread::get_id())));
+    return rng;
+}
+
+} // namespace
+
+namespace verify_detail {
+
+bool Sample() {
+    return std::uniform_real_distribution<double>(0.0, 1.0)(SamplingRng()) < probability;
+}
+
+} // namespace verify_detail
+
+void EnableVerification(double probability, unsigned int seed, const std::string& command) {
+    verify_detail::probability = probability;
+    run_seed = seed;
+    run_command = command;
+}
+
+void SetVerifyContext(long long restart, long long search) {
+    context = {restart, search};
+}
+
+void VerifyMove(const Data& data, const Solution& after, const char* move, double before, double predicted_delta,
+                double lambda) {
+    verified++;
+    double actual = SolutionCost(data, after);
+    if (lambda > 0.0) {
+        actual += lambda * static_cast<double>(SolutionViolation(data, after));
+    }
+    double predicted = before + predicted_delta;
+    bool cost_ok = std::abs(actual - predicted) <= 1e-6 * std::max(1.0, std::abs(actual));
+
+    std::vector<size_t> infeasible;
+    if (lambda == 0.0) {
+        for (size_t r = 0; r < after.routes.size(); ++r) {
+            if (!CheckRouteFeasible(data, after.routes[r]).ok) {
+                infeasible.push_back(r);
+            }
+        }
+    }
+    if (cost_ok && infeasible.empty()) {
+        return;
+    }
+
+    // Mensagem inteira de uma vez: outras threads podem estar verificando
+    std::ostringstream out;
+    out << "Erro: verificação falhou no movimento " << move << "\n";
+    out << "  objetivo previsto: " << predicted << " (antes " << before << ", variação " << predicted_delta
+        << "), recalculado: " << actual;
+    if (lambda > 0.0) {
+        out << " (λ = " << lambda << ")";
+    }
+    out << "\n";
+    for (size_t r : infeasible) {
+        out << "  rota " << r << " inviável (violação " << CheckRouteFeasible(data, after.routes[r]).cap_violation
+            << "):";
+        for (int v : after.routes[r].nodes) {
+            out << " " << v;
+        }
+        out << "\n";
+    }
+    out << "  semente " << run_seed << ", reinício " << context.restart << ", busca local " << context.search << "\n";
+    out << "  reproduza com: " << run_command << "\n";
+    std::cerr << out.str() << std::flush;
+    // abort em vez de exit: outras threads continuam rodando e não devem ver destrutores estáticos
+    std::abort();
+}
+
+long long VerifiedMoves() {
+    return verified.load();
+}
@@ -0,0 +1,38 @@
+#ifndef VERIFY_H
+#define VERIFY_H
+
+#include <string>
+#include "Construction.h"
+#include "Instance.h"
+
+// Verificação diferencial (--verify P): uma fração P dos movimentos aceitos pelas buscas tem a
+// previsão do avaliador (variação do objetivo e viabilidade) conferida contra SolutionCost e
+// CheckRouteFeasible. Uma divergência encerra o processo com um reprodutor (comando, semente,
+// reinício, busca local e movimento). O sorteio usa um gerador próprio por thread, então
+// verificar não muda a busca. Desligada, cada ponto de verificação custa a leitura de um flag.
+
+namespace verify_detail {
+extern double probability;
+bool Sample();
+} // namespace verify_detail
+
+// Liga a verificação; `command` é a linha de comando que reproduz a execução (vai no reprodutor)
+void EnableVerification(double probability, unsigned int seed, const std::string& command);
+
+// O próximo movimento aceito deve ser conferido? (sorteio com a probabilidade configurada)
+inline bool VerifyNextMove() {
+    return verify_detail::probability > 0.0 && verify_detail::Sample();
+}
+
+// Posição da thread atual na busca, para o reprodutor
+void SetVerifyContext(long long restart, long long search);
+
+// Confere um movimento aceito: o objetivo após o movimento (custo + lambda·violação) deve ser
+// before + predicted_delta; com lambda == 0 todas as rotas devem ser viáveis
+void VerifyMove(const Data& data, const Solution& after, const char* move, double before, double predicted_delta,
+                double lambda = 0.0);
+
+// Número de movimentos conferidos até aqui (todas as threads)
+[[nodiscard]] long long VerifiedMoves();
+
+#endif
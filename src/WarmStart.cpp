@@ -0,0 +1,152 @@
+#include "WarmStart.h"
+#include "Feasibility.h"
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+// Ejeta, uma a uma, a estação cuja remoção mais reduz a violação de capacidade (empate:
+// maior economia de custo) até a rota voltar a ser viável
+static void EjectUntilFeasible(const Data& data, Route& route, std::vector<int>& ejected) {
+    while (!CheckRouteFeasible(data, route).ok && route.nodes.size() > 2) {
+        size_t best_pos = 1;
+        long long best_violation = std::numeric_limits<long long>::max();
+        double best_saving = -std::numeric_limits<double>::infinity();
+
+        for (size_t pos = 1; pos < route.nodes.size() - 1; ++pos) {
+            Route test_route = route;
+            test_route.nodes.erase(test_route.nodes.begin() + pos);
+            long long violation = CheckRouteFeasible(data, test_route).cap_violation;
+
+            int prev = route.nodes[pos - 1];
+            int node = route.nodes[pos];
+            int next = route.nodes[pos + 1];
+            double saving = data.getTravelCost(prev, node) + data.getTravelCost(node, next) -
+                            data.getTravelCost(prev, next);
+
+            if (violation < best_violation || (violation == best_violation && saving > best_saving)) {
+                best_violation = violation;
+                best_saving = saving;
+                best_pos = pos;
+            }
+        }
+
+        ejected.push_back(route.nodes[best_pos]);
+        route.nodes.erase(route.nodes.begin() + best_pos);
+    }
+}
+
+Solution RepairSolution(const Data& data, const Solution& previous, RepairStats& stats) {
+    const int n_stations = data.getNumStations();
+    const int max_vehicles = data.getNumVehicles();
+    const long long Q = static_cast<long long>(data.getVehicleCapacity());
+
+    stats = RepairStats{};
+    Solution solution;
+    std::vector<bool> seen(n_stations + 1, false);
+    std::vector<int> pending;
+
+    // Mantém a sequência de cada rota, descartando depósitos internos, ids inválidos e repetições
+    for (const auto& old_route : previous.routes) {
+        Route route;
+        route.nodes.push_back(0);
+        for (int node : old_route.nodes) {
+            if (node == 0) {
+                continue;
+            }
+            if (node < 1 || node > n_stations || seen[node]) {
+                stats.missing++;
+                continue;
+            }
+            seen[node] = true;
+            route.nodes.push_back(node);
+        }
+        route.nodes.push_back(0);
+
+        if (route.nodes.size() <= 2) {
+            continue;
+        }
+        if (!CheckRouteFeasible(data, route).ok) {
+            stats.routes_repaired++;
+            size_t before = pending.size();
+            EjectUntilFeasible(data, route, pending);
+            stats.ejected += static_cast<int>(pending.size() - before);
+        }
+        if (route.nodes.size() > 2) {
+            solution.routes.push_back(route);
+        }
+    }
+
+    for (int station = 1; station <= n_stations; ++station) {
+        if (!seen[station]) {
+            stats.missing++;
+            pending.push_back(station);
+        }
+    }
+
+    // Estações mais difíceis (maior |q|) primeiro
+    std::sort(pending.begin(), pending.end(), [&data](int a, int b) {
+        long long da = std::llabs(NodeDemand(data, a));
+        long long db = std::llabs(NodeDemand(data, b));
+        return da != db ? da > db : a < b;
+    });
+
+    // Descarta rotas excedentes ao número de veículos, devolvendo suas estações à fila
+    while (static_cast<int>(solution.routes.size()) > max_vehicles) {
+        const Route& dropped = solution.routes.back();
+        pending.insert(pending.end(), dropped.nodes.begin() + 1, dropped.nodes.end() - 1);
+        solution.routes.pop_back();
+    }
+
+    std::vector<RouteLoadProfile> profiles(solution.routes.size());
+    for (size_t r = 0; r < solution.routes.size(); ++r) {
+        BuildLoadProfile(data, solution.routes[r], profiles[r]);
+    }
+
+    bool all_inserted = true;
+    for (int station : pending) {
+        const long long demand = NodeDemand(data, station);
+        size_t best_route = 0;
+        size_t best_pos = 0;
+        double best_delta = std::numeric_limits<double>::infinity();
+
+        for (size_t r = 0; r < solution.routes.size(); ++r) {
+            const Route& route = solution.routes[r];
+            for (size_t pos = 1; pos < route.nodes.size(); ++pos) {
+                if (!CanInsertAt(profiles[r], pos, demand, Q)) {
+                    continue;
+                }
+                int prev = route.nodes[pos - 1];
+                int next = route.nodes[pos];
+                double delta = data.getTravelCost(prev, station) + data.getTravelCost(station, next) -
+                               data.getTravelCost(prev, next);
+                if (delta < best_delta) {
+                    best_delta = delta;
+                    best_route = r;
+                    best_pos = pos;
+                }
+            }
+        }
+
+        if (best_delta == std::numeric_limits<double>::infinity()) {
+            if (static_cast<int>(solution.routes.size()) >= max_vehicles || std::llabs(demand) > Q) {
+                all_inserted = false;
+                continue;
+            }
+            Route new_route;
+            new_route.nodes = {0, station, 0};
+            solution.routes.push_back(new_route);
+            profiles.emplace_back();
+            BuildLoadProfile(data, solution.routes.back(), profiles.back());
+            stats.new_routes++;
+            continue;
+        }
+
+        Route& route = solution.routes[best_route];
+        route.nodes.insert(route.nodes.begin() + best_pos, station);
+        BuildLoadProfile(data, route, profiles[best_route]);
+    }
+
+    stats.complete = all_inserted;
+    solution.total_cost = SolutionCost(data, solution);
+    return solution;
+}
@@ -0,0 +1,20 @@
+#ifndef WARM_START_H
+#define WARM_START_H
+
+#include "Construction.h"
+#include "Instance.h"
+
+struct RepairStats {
+    int  routes_repaired = 0;  // rotas que ficaram inviáveis com as demandas atuais
+    int  ejected         = 0;  // estações ejetadas dessas rotas
+    int  missing         = 0;  // estações ausentes, repetidas ou inválidas no arquivo
+    int  new_routes      = 0;  // rotas abertas durante a reinserção
+    bool complete        = false;  // todas as estações voltaram à solução
+};
+
+// Ajusta uma solução anterior às demandas atuais da instância: descarta nós inválidos ou
+// repetidos, ejeta estações apenas das rotas cuja janela de carga ficou inviável e reinsere
+// as pendentes na posição viável mais barata. Rotas que continuam viáveis não são tocadas.
+[[nodiscard]] Solution RepairSolution(const Data& data, const Solution& previous, RepairStats& stats);
+
+#endif
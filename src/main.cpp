@@ -3,8 +3,12 @@
 #include "Construction.h"
 #include "Argparse.h"
 #include "Output.h"
-#include "LocalSearch.h"
-#include "ILS.h"
+#include "Daemon.h"
+#include "Solver.h"
+#include "Trace.h"
+#include "Verify.h"
+#include "ProcStats.h"
+#include <memory>
 #include <string>
 #include <random>
 #include <chrono>
@@ -21,7 +25,7 @@ void PrintSolution(const Data& data, const Solution& solution) {
         cout << "Rota " << (i + 1) << ": ";
 
         for (size_t j = 0; j < route.nodes.size(); ++j) {
-            cout << route.nodes[j];
+            cout << data.getOriginalId(route.nodes[j]);
             if (j < route.nodes.size() - 1) {
                 cout << " -> ";
             }
@@ -44,8 +48,35 @@ int main(int argc, char *argv[]) {
     // Processa argumentos da linha de comando
     CLIOptions opts = ParseCLI(argc, argv);
 
+    if (opts.daemon) {
+        return RunDaemon({opts.socket_path, opts.cache_size});
+    }
+
     std::mt19937 rng(opts.seed);
 
+    std::unique_ptr<TraceSink> trace;
+    if (!opts.trace_path.empty()) {
+        trace = std::make_unique<TraceSink>(opts.trace_path);
+        if (!trace->ok()) {
+            cout << "Erro: não foi possível criar " << opts.trace_path << endl;
+            return 1;
+        }
+    }
+
+    if (opts.verify > 0.0) {
+        // Mesma linha de comando, mas conferindo todos os movimentos
+        std::string command = argv[0];
+        for (int i = 1; i < argc; ++i) {
+            if (std::string(argv[i]) == "--verify" && i + 1 < argc) {
+                ++i;
+                continue;
+            }
+            command += std::string(" ") + argv[i];
+        }
+        command += " --verify 1";
+        EnableVerification(opts.verify, opts.seed, command);
+    }
+
     if (opts.verbose) {
         cout << "=== Solver JP-Bike Rebalancing ===" << endl;
         cout << "Semente aleatória: " << opts.seed << endl;
@@ -70,7 +101,46 @@ int main(int argc, char *argv[]) {
     if (opts.verbose) {
         cout << "Carregando instância do sistema JP-Bike..." << endl;
     }
-    data->read();
+    data->useSharedMemory(opts.shared_memory);
+    {
+        PhaseTimer timer(trace.get(), "io");
+        data->read();
+    }
+    if (opts.verbose && data->isShared()) {
+        cout << "Matriz em memória compartilhada ("
+             << (data->attachedShared() ? "segmento existente anexado" : "segmento criado") << ")" << endl;
+    }
+
+    if (trace) {
+        std::string method = opts.decompose ? "decompose" : opts.use_ils ? "ils" : opts.constructive_method;
+        trace->run(opts.instance_path, opts.seed, method,
+                   {{"n", data->getNumStations()},
+                    {"m", data->getNumVehicles()},
+                    {"Q", data->getVehicleCapacity()},
+                    {"max_iter", opts.max_iter},
+                    {"max_iter_ils", opts.max_iter_ils},
+                    {"alpha_min", opts.rcl_alpha_min},
+                    {"alpha_max", opts.rcl_alpha_max},
+                    {"perturb_strength", opts.perturb_strength},
+                    {"time_limit", opts.time_limit},
+                    {"threads", opts.threads},
+                    {"batch", opts.batch},
+                    {"grasp_threads", opts.grasp_threads},
+                    {"elite", opts.elite_size},
+                    {"relink_every", opts.relink_every},
+                    {"relink_pairs", opts.relink_pairs},
+                    {"penalized", opts.penalized ? 1.0 : 0.0},
+                    {"penalty_target", opts.penalty_target},
+                    {"resequence", opts.resequence ? 1.0 : 0.0},
+                    {"or_opt", opts.or_opt_max},
+                    {"decompose_size", opts.decompose ? opts.decompose_size : 0},
+                    {"aggregate", opts.aggregate ? opts.aggregate_threshold : -1.0},
+                    {"vnd", opts.use_vnd ? 1.0 : 0.0},
+                    {"renumber", opts.renumber ? 1.0 : 0.0},
+                    {"shm", opts.shared_memory ? 1.0 : 0.0},
+                    {"verify", opts.verify},
+                    {"warm_start", opts.warm_start_path.empty() ? 0.0 : 1.0}});
+    }
     
     if (opts.verbose) {
         cout << "\n";
@@ -146,48 +216,57 @@ int main(int argc, char *argv[]) {
         }
     }
 
-    auto start_time = std::chrono::high_resolution_clock::now();
-    Solution solution;
-
-    // Execute ILS or traditional constructive + VND
-    if (opts.use_ils) {
-        ILSParams ils_params{
-            opts.max_iter,
-            opts.max_iter_ils,
-            opts.rcl_alpha_min,
-            opts.rcl_alpha_max,
-            opts.perturb_strength
-        };
-        solution = ILS(*data, rng, ils_params, opts.verbose);
-    } else {
-        if (opts.verbose) {
-            cout << "\n=== Executando Heurística Construtiva ===" << endl;
-        }
-
-        if (opts.constructive_method == "nearest") {
-            if (opts.verbose) {
-                cout << "Aplicando algoritmo Greedy Nearest-Feasible..." << endl;
-            }
-            solution = GreedyNearestFeasible(*data, rng);
-        } else if (opts.constructive_method == "insertion") {
-            if (opts.verbose) {
-                cout << "Aplicando algoritmo Greedy Best-Insertion..." << endl;
-            }
-            solution = GreedyBestInsertion(*data, rng);
-        } else {
-            cerr << "Método construtivo desconhecido: " << opts.constructive_method << endl;
+    // Warm start: a solução anterior é lida aqui e reparada por Solve
+    Solution previous;
+    if (!opts.warm_start_path.empty()) {
+        PhaseTimer timer(trace.get(), "io");
+        if (!ReadSolution(opts.warm_start_path, previous)) {
             delete data;
             return 1;
         }
+        if (opts.verbose) {
+            cout << "\nWarm start: " << opts.warm_start_path << endl;
+        }
     }
 
-    auto end_time = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+    SolverOptions solver_options;
+    solver_options.seed = opts.seed;
+    solver_options.use_ils = opts.use_ils;
+    solver_options.constructive = opts.constructive_method;
+    solver_options.use_vnd = opts.use_vnd;
+    solver_options.decompose = opts.decompose;
+    solver_options.decompose_size = opts.decompose_size;
+    solver_options.renumber = opts.renumber;
+    solver_options.aggregate = opts.aggregate;
+    solver_options.aggregate_threshold = opts.aggregate_threshold;
+    solver_options.warm_start = opts.warm_start_path.empty() ? nullptr : &previous;
+    solver_options.ils = ILSParams{opts.max_iter, opts.max_iter_ils, opts.rcl_alpha_min, opts.rcl_alpha_max,
+                                   opts.perturb_strength};
+    solver_options.ils.time_limit = opts.time_limit;
+    solver_options.ils.threads = opts.threads;
+    solver_options.ils.batch = opts.batch;
+    solver_options.ils.elite_size = opts.elite_size;
+    solver_options.ils.relink_every = opts.relink_every;
+    solver_options.ils.relink_pairs = opts.relink_pairs;
+    solver_options.ils.penalized = opts.penalized;
+    solver_options.ils.penalty_target = opts.penalty_target;
+    solver_options.ils.resequence = opts.resequence;
+    solver_options.ils.or_opt_max = opts.or_opt_max;
+    solver_options.ils.grasp_threads = opts.grasp_threads;
+    solver_options.ils.trace = trace.get();
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+    SolveResult result = Solve(*data, solver_options, opts.verbose);
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() -
+                                                                          start_time);
+    const Solution& solution = result.constructed;
+    const Solution& final_solution = result.solution;
+    const bool use_warm_start = result.warm_started;
 
     if (opts.verbose) {
-        cout << "Tempo de construção: " << duration.count() << " ms" << endl;
+        cout << "Tempo de resolução: " << duration.count() << " ms" << endl;
 
-        // Exibe a solução construída
+        // Exibe a solução do método (antes do VND)
         PrintSolution(*data, solution);
     }
 
@@ -202,42 +281,11 @@ int main(int argc, char *argv[]) {
         cout << "ATENÇÃO: A solução construída possui problemas de viabilidade." << endl;
     }
 
-    // Aplicar VND se habilitado (apenas para métodos não-ILS)
-    Solution final_solution = solution;
-    if (opts.use_vnd && !opts.use_ils) {
-        if (opts.verbose) {
-            cout << "\n=== VND (Variable Neighborhood Descent) ===" << endl;
-            cout << "Custo inicial: " << solution.total_cost << endl;
-        }
-
-        auto vnd_start = std::chrono::high_resolution_clock::now();
-        auto neighborhoods = GetDefaultNeighborhoods();
-        final_solution = VND(*data, solution, rng, neighborhoods);
-        auto vnd_end = std::chrono::high_resolution_clock::now();
-
-        auto vnd_duration = std::chrono::duration_cast<std::chrono::milliseconds>(vnd_end - vnd_start);
-
-        if (opts.verbose) {
-            cout << "Custo final após VND: " << final_solution.total_cost << endl;
-            cout << "Melhoria: " << (solution.total_cost - final_solution.total_cost) << endl;
-            cout << "Tempo VND: " << vnd_duration.count() << " ms" << endl;
-        }
-
-        // Verifica se VND manteve viabilidade
-        bool vnd_feasible = CheckSolutionFeasible(*data, final_solution.routes);
-        if (!vnd_feasible) {
-            if (opts.verbose) {
-                cout << "ATENÇÃO: VND produziu solução inviável! Usando apenas a solução construtiva." << endl;
-            }
-            final_solution = solution;
-        }
-    }
-
-    // Verifica viabilidade final
-    bool final_feasible = CheckSolutionFeasible(*data, final_solution.routes);
+    bool final_feasible = result.feasible;
 
     // Salva a solução final no arquivo de saída apenas se viável
     if (final_feasible) {
+        PhaseTimer timer(trace.get(), "io");
         std::string output_filename = opts.output_dir + data->getInstanceName() + ".out";
         WriteSolution(output_filename, *data, final_solution);
     }
@@ -246,10 +294,10 @@ int main(int argc, char *argv[]) {
     cout << "Instância: " << data->getInstanceName() << endl;
     
     if (opts.use_ils) {
-        cout << "Método: ILS (Iterated Local Search)" << endl;
+        cout << "Método: ILS (Iterated Local Search)" << (opts.decompose ? " por decomposição" : "") << endl;
         cout << "Custo final: " << final_solution.total_cost << endl;
     } else {
-        cout << "Método: " << opts.constructive_method << endl;
+        cout << "Método: " << (use_warm_start ? "warm-start" : opts.constructive_method) << endl;
         if (opts.use_vnd) {
             cout << "Custo construtivo: " << solution.total_cost << endl;
             cout << "Custo após VND: " << final_solution.total_cost << endl;
@@ -260,9 +308,32 @@ int main(int argc, char *argv[]) {
     }
     cout << "Veículos utilizados: " << final_solution.routes.size() << "/" << data->getNumVehicles() << endl;
     cout << "Viável: " << (final_feasible ? "SIM" : "NÃO") << endl;
+    if (opts.verify > 0.0 && opts.verbose) {
+        cout << "Movimentos verificados: " << VerifiedMoves() << endl;
+    }
+    if (kAllocStatsEnabled && opts.verbose) {
+        AllocCounts allocated = ProcessAllocCounts();
+        cout << "Alocações: " << allocated.allocations << " (" << allocated.bytes << " bytes), pico de RSS: "
+             << ReadProcStatusKb("VmHWM") << " kB" << endl;
+    }
 
     if (!final_feasible) {
         cerr << "\nERRO: Solução final é inviável - arquivo .out não foi gerado!" << endl;
+        if (!result.warning.empty()) {
+            cerr << result.warning << endl;
+        }
+    }
+
+    if (trace) {
+        if (!opts.use_ils) {
+            std::string method = use_warm_start ? "warm-start" : opts.constructive_method;
+            trace->improvement(0, 1, 0.0, method + (opts.use_vnd ? "+vnd" : ""),
+                               final_solution.total_cost);
+        }
+        if (opts.verify > 0.0) {
+            trace->addCounter("verified_moves", static_cast<double>(VerifiedMoves()));
+        }
+        trace->finish();
     }
 
     delete data;
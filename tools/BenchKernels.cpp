@@ -0,0 +1,337 @@
+// Microbenchmarks dos kernels do solver (viabilidade, custo, vizinhanças, perturbação e
+// construtivos) sobre instâncias sintéticas de tamanhos crescentes. Reporta ns/op, ops/s
+// e, quando disponíveis, ciclos, instruções e cache misses por operação.
+
+#include "Construction.h"
+#include "Feasibility.h"
+#include "Generator.h"
+#include "ILS.h"
+#include "Instance.h"
+#include "LinkedSolution.h"
+#include "LocalSearch.h"
+#include "Locality.h"
+#include "PerfCounters.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct BenchConfig {
+    std::vector<int> sizes = {25, 50, 100, 200};
+    unsigned int seed = 42;
+    int capacity = 20;
+    double min_time = 0.2;
+    int slow_max_n = 200; // construtivos O(n^3) ou piores são pulados acima disso
+    int rvnd_max_n = 1000; // acima disso não há ótimo local do RVND (ver BenchSize)
+    int grasp_threads = 1; // threads da avaliação de candidatos em BuildInitial_GRASP
+    std::string filter;
+    std::string order = "file"; // numeração das estações: file, shuffle ou locality
+    bool csv = false;
+};
+
+volatile double g_sink = 0.0;
+
+void PrintHeader(const BenchConfig& cfg, bool counters) {
+    if (cfg.csv) {
+        std::printf("kernel,n,ops,ns_per_op,ops_per_s,cycles_per_op,instructions_per_op,cache_misses_per_op\n");
+        return;
+    }
+    if (!counters) {
+        std::printf("# contadores de hardware indisponíveis (perf_event_open)\n");
+    }
+    std::printf("%-28s %6s %10s %14s %14s %10s %10s %10s\n", "kernel", "n", "ops", "ns/op", "ops/s", "cyc/op",
+                "instr/op", "miss/op");
+}
+
+std::string FormatCounter(bool has, uint64_t value, long long ops, bool csv) {
+    if (!has) {
+        return csv ? "" : "-";
+    }
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.1f", static_cast<double>(value) / static_cast<double>(ops));
+    return buf;
+}
+
+// Executa lotes crescentes de operações até que um lote dure pelo menos min_time; só o
+// último lote é reportado. prepare(k) monta, fora da medição, o estado de k operações.
+void RunKernel(const BenchConfig& cfg, PerfCounters& perf, const std::string& name, int n,
+               const std::function<void(long long)>& prepare, const std::function<void(long long)>& op) {
+    if (!cfg.filter.empty() && name.find(cfg.filter) == std::string::npos) {
+        return;
+    }
+
+    using Clock = std::chrono::steady_clock;
+    long long ops = 1;
+    double elapsed = 0.0;
+    PerfSample sample;
+
+    while (true) {
+        prepare(ops);
+        perf.start();
+        auto t0 = Clock::now();
+        for (long long i = 0; i < ops; ++i) {
+            op(i);
+        }
+        auto t1 = Clock::now();
+        sample = perf.stop();
+        elapsed = std::chrono::duration<double>(t1 - t0).count();
+
+        if (elapsed >= cfg.min_time || ops >= (1LL << 30)) {
+            break;
+        }
+        double scale = elapsed > 0.0 ? 1.2 * cfg.min_time / elapsed : 16.0;
+        ops = std::max(ops * 2, static_cast<long long>(ops * std::min(scale, 16.0)));
+    }
+
+    double ns_per_op = elapsed * 1e9 / static_cast<double>(ops);
+    double ops_per_s = static_cast<double>(ops) / elapsed;
+    std::string cyc = FormatCounter(sample.has_cycles, sample.cycles, ops, cfg.csv);
+    std::string ins = FormatCounter(sample.has_instructions, sample.instructions, ops, cfg.csv);
+    std::string mis = FormatCounter(sample.has_cache_misses, sample.cache_misses, ops, cfg.csv);
+
+    if (cfg.csv) {
+        std::printf("%s,%d,%lld,%.1f,%.1f,%s,%s,%s\n", name.c_str(), n, ops, ns_per_op, ops_per_s, cyc.c_str(),
+                    ins.c_str(), mis.c_str());
+    } else {
+        std::printf("%-28s %6d %10lld %14.1f %14.1f %10s %10s %10s\n", name.c_str(), n, ops, ns_per_op, ops_per_s,
+                    cyc.c_str(), ins.c_str(), mis.c_str());
+    }
+    std::fflush(stdout);
+}
+
+void NoPrepare(long long) {}
+
+void BenchSize(const BenchConfig& cfg, PerfCounters& perf, int n) {
+    GeneratorParams gen;
+    gen.n = n;
+    gen.Q = cfg.capacity;
+    gen.seed = cfg.seed + static_cast<uint64_t>(n);
+    std::unique_ptr<Data> data_ptr = GenerateInstance(gen);
+    std::mt19937 rng(cfg.seed);
+
+    // Solução construtiva (ainda melhorável) e ótimo local do RVND como estados de referência,
+    // construídos na numeração do arquivo. Com milhares de estações o RVND de preparo leva
+    // dezenas de minutos; acima de rvnd_max_n o estado "ótimo" é a solução de Clarke-Wright
+    // (rotas espacialmente coesas, como as de um ótimo local) e os kernels RVND são pulados.
+    const bool local_search_setup = n <= cfg.rvnd_max_n;
+    Solution constructed = GreedyNearestFeasible(*data_ptr, rng);
+    Solution local_opt = local_search_setup ? RVND(*data_ptr, constructed, rng) : ClarkeWrightSavings(*data_ptr, rng);
+    if (!local_search_setup) {
+        std::fprintf(stderr, "n = %d: estado de referência de Clarke-Wright, sem kernels RVND (--rvnd-max-n %d)\n", n,
+                     cfg.rvnd_max_n);
+    }
+
+    // Mesma instância e mesmas rotas sob outra numeração: só a localidade de acesso da busca
+    // local muda entre --order file, shuffle e locality
+    if (cfg.order == "shuffle") {
+        std::vector<int> order(n);
+        for (int v = 1; v <= n; ++v) {
+            order[v - 1] = v;
+        }
+        std::mt19937 shuffle_rng(gen.seed);
+        std::shuffle(order.begin(), order.end(), shuffle_rng);
+        data_ptr->renumber(order);
+    } else if (cfg.order == "locality") {
+        data_ptr->renumber(LocalityOrder(*data_ptr));
+    }
+    const Data& data = *data_ptr;
+    if (data.isRenumbered()) {
+        constructed = ToInternalIds(data, constructed);
+        local_opt = ToInternalIds(data, local_opt);
+    }
+    std::vector<Solution> batch;
+
+    auto copies_of = [&batch](const Solution& base) {
+        return [&batch, &base](long long k) { batch.assign(static_cast<size_t>(k), base); };
+    };
+
+    RunKernel(cfg, perf, "CheckRouteFeasible", n, NoPrepare, [&](long long i) {
+        const Route& route = local_opt.routes[static_cast<size_t>(i) % local_opt.routes.size()];
+        g_sink = g_sink + static_cast<double>(CheckRouteFeasible(data, route).L0_max);
+    });
+    RunKernel(cfg, perf, "RouteCost", n, NoPrepare, [&](long long i) {
+        g_sink = g_sink + RouteCost(data, local_opt.routes[static_cast<size_t>(i) % local_opt.routes.size()]);
+    });
+    RunKernel(cfg, perf, "SolutionCost", n, NoPrepare, [&](long long) { g_sink = g_sink + SolutionCost(data, local_opt); });
+
+    struct Step {
+        const char* name;
+        bool (*fn)(const Data&, Solution&, std::mt19937&, double&);
+    };
+    const Step steps[] = {
+        {"RelocateStep", RelocateStep},
+        {"SwapStep", SwapStep},
+        {"TwoOptStep", TwoOptStep},
+        {"OrOpt2Step", OrOpt2Step},
+        {"OrOpt3Step", [](const Data& d, Solution& s, std::mt19937&, double& p) { return OrOptStep(d, s, 3, p); }},
+    };
+
+    for (const Step& step : steps) {
+        // "improve": primeira melhora a partir da construtiva; "scan": varredura completa sem melhora
+        RunKernel(cfg, perf, std::string(step.name) + "/improve", n, copies_of(constructed), [&](long long i) {
+            double predicted = 0.0;
+            g_sink = g_sink + step.fn(data, batch[static_cast<size_t>(i)], rng, predicted) + predicted;
+        });
+        Solution scan_solution = local_opt;
+        RunKernel(cfg, perf, std::string(step.name) + "/scan", n, NoPrepare, [&](long long) {
+            double predicted = 0.0;
+            g_sink = g_sink + step.fn(data, scan_solution, rng, predicted);
+        });
+    }
+
+    RunKernel(cfg, perf, "ApplyRandomPerturbation", n, copies_of(local_opt), [&](long long i) {
+        ApplyRandomPerturbation(data, batch[static_cast<size_t>(i)], rng, 2);
+        g_sink = g_sink + batch[static_cast<size_t>(i)].total_cost;
+    });
+    // Aplicação de relocate aleatório: vetores (busca linear + erase/insert) x listas encadeadas
+    Solution vector_state = local_opt;
+    RunKernel(cfg, perf, "VectorRoutes/relocate", n, NoPrepare, [&](long long) {
+        int v = 1 + static_cast<int>(rng() % static_cast<unsigned>(n));
+        int after = static_cast<int>(rng() % static_cast<unsigned>(n + 1));
+        auto locate = [&](int node, size_t& r, size_t& p) {
+            for (r = 0; r < vector_state.routes.size(); ++r) {
+                auto& nodes = vector_state.routes[r].nodes;
+                auto it = std::find(nodes.begin() + 1, nodes.end() - 1, node);
+                if (it != nodes.end() - 1) {
+                    p = static_cast<size_t>(it - nodes.begin());
+                    return;
+                }
+            }
+            r = 0;
+            p = 0;
+        };
+        if (after == v) return;
+        size_t rv, pv, ra, pa;
+        locate(v, rv, pv);
+        vector_state.routes[rv].nodes.erase(vector_state.routes[rv].nodes.begin() + pv);
+        locate(after, ra, pa);
+        vector_state.routes[ra].nodes.insert(vector_state.routes[ra].nodes.begin() + pa + 1, v);
+    });
+    LinkedSolution linked_state(data, local_opt);
+    RunKernel(cfg, perf, "LinkedSolution/relocate", n, NoPrepare, [&](long long) {
+        int v = 1 + static_cast<int>(rng() % static_cast<unsigned>(n));
+        int after = static_cast<int>(rng() % static_cast<unsigned>(n + 1));
+        if (after == v) return;
+        linked_state.relocate(v, after == 0 ? linked_state.depotOf(0) : after);
+        g_sink = g_sink + linked_state.totalCost();
+    });
+    RunKernel(cfg, perf, "LinkedSolution/convert", n, NoPrepare, [&](long long) {
+        LinkedSolution linked(data, local_opt);
+        g_sink = g_sink + linked.toSolution().total_cost;
+    });
+
+    // Pipeline especializado em tempo de compilação x lista de std::function em tempo de execução
+    // (mesmos movimentos); "scan" parte do ótimo local, onde só a varredura e o despacho contam
+    const std::vector<NeighborhoodFunction> functions = GetDefaultNeighborhoods();
+    if (local_search_setup) {
+        RunKernel(cfg, perf, "RVND", n, NoPrepare,
+                  [&](long long) { g_sink = g_sink + RVND(data, constructed, rng).total_cost; });
+        RunKernel(cfg, perf, "RVND/function", n, NoPrepare, [&](long long) {
+            g_sink = g_sink + RVND(data, constructed, rng, functions, GetDefaultNeighborhoodNames()).total_cost;
+        });
+        RunKernel(cfg, perf, "RVND/scan", n, NoPrepare,
+                  [&](long long) { g_sink = g_sink + RVND(data, local_opt, rng).total_cost; });
+        RunKernel(cfg, perf, "RVND/scan/function", n, NoPrepare, [&](long long) {
+            g_sink = g_sink + RVND(data, local_opt, rng, functions, GetDefaultNeighborhoodNames()).total_cost;
+        });
+    }
+
+    RunKernel(cfg, perf, "GreedyNearestFeasible", n, NoPrepare,
+              [&](long long) { g_sink = g_sink + GreedyNearestFeasible(data, rng).total_cost; });
+    RunKernel(cfg, perf, "ClarkeWrightSavings", n, NoPrepare,
+              [&](long long) { g_sink = g_sink + ClarkeWrightSavings(data, rng).total_cost; });
+    if (n <= cfg.slow_max_n) {
+        RunKernel(cfg, perf, "GreedyBestInsertion", n, NoPrepare,
+                  [&](long long) { g_sink = g_sink + GreedyBestInsertion(data, rng).total_cost; });
+        RunKernel(cfg, perf, "BuildInitial_GRASP", n, NoPrepare,
+                  [&](long long) { g_sink = g_sink + BuildInitial_GRASP(data, rng, 0.3, cfg.grasp_threads).total_cost; });
+    }
+}
+
+void PrintBenchUsage(const char* program_name) {
+    std::cout << "Uso: " << program_name << " [opções]" << std::endl;
+    std::cout << "Opções:" << std::endl;
+    std::cout << "  --sizes A,B,...      Tamanhos de instância (padrão: 25,50,100,200)" << std::endl;
+    std::cout << "  --seed N             Semente das instâncias e do RNG (padrão: 42)" << std::endl;
+    std::cout << "  --capacity Q         Capacidade dos veículos (padrão: 20)" << std::endl;
+    std::cout << "  --min-time S         Duração mínima de cada medição em segundos (padrão: 0.2)" << std::endl;
+    std::cout << "  --slow-max-n N       Maior n para construtivos O(n^3) (padrão: 200)" << std::endl;
+    std::cout << "  --rvnd-max-n N       Maior n com ótimo local do RVND como estado de referência e kernels RVND;" << std::endl;
+    std::cout << "                       acima disso o estado é a solução de Clarke-Wright (padrão: 1000)" << std::endl;
+    std::cout << "  --grasp-threads N    Threads da avaliação de candidatos no BuildInitial_GRASP (padrão: 1)" << std::endl;
+    std::cout << "  --filter TEXTO       Executa apenas kernels cujo nome contém TEXTO" << std::endl;
+    std::cout << "  --order TIPO         Numeração das estações: file, shuffle ou locality (padrão: file)" << std::endl;
+    std::cout << "  --csv                Saída em CSV" << std::endl;
+}
+
+BenchConfig ParseBenchCLI(int argc, char* argv[]) {
+    BenchConfig cfg;
+    for (int i = 1; i < argc; ++i) {
+        bool has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--sizes") == 0 && has_value) {
+            cfg.sizes.clear();
+            std::stringstream ss(argv[++i]);
+            std::string item;
+            while (std::getline(ss, item, ',')) {
+                cfg.sizes.push_back(std::stoi(item));
+            }
+        } else if (strcmp(argv[i], "--seed") == 0 && has_value) {
+            cfg.seed = static_cast<unsigned int>(std::stoul(argv[++i]));
+        } else if (strcmp(argv[i], "--capacity") == 0 && has_value) {
+            cfg.capacity = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--min-time") == 0 && has_value) {
+            cfg.min_time = std::stod(argv[++i]);
+        } else if (strcmp(argv[i], "--slow-max-n") == 0 && has_value) {
+            cfg.slow_max_n = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--rvnd-max-n") == 0 && has_value) {
+            cfg.rvnd_max_n = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--grasp-threads") == 0 && has_value) {
+            cfg.grasp_threads = std::stoi(argv[++i]);
+            if (cfg.grasp_threads < 1) {
+                std::cout << "Erro: --grasp-threads deve ser maior que 0" << std::endl;
+                exit(1);
+            }
+        } else if (strcmp(argv[i], "--filter") == 0 && has_value) {
+            cfg.filter = argv[++i];
+        } else if (strcmp(argv[i], "--order") == 0 && has_value) {
+            cfg.order = argv[++i];
+            if (cfg.order != "file" && cfg.order != "shuffle" && cfg.order != "locality") {
+                std::cout << "Erro: --order deve ser 'file', 'shuffle' ou 'locality'" << std::endl;
+                exit(1);
+            }
+        } else if (strcmp(argv[i], "--csv") == 0) {
+            cfg.csv = true;
+        } else if (strcmp(argv[i], "--help") == 0) {
+            PrintBenchUsage(argv[0]);
+            exit(0);
+        } else {
+            std::cout << "Erro: opção desconhecida ou sem valor: " << argv[i] << std::endl;
+            PrintBenchUsage(argv[0]);
+            exit(1);
+        }
+    }
+    return cfg;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    BenchConfig cfg = ParseBenchCLI(argc, argv);
+    PerfCounters perf;
+
+    PrintHeader(cfg, perf.available());
+    for (int n : cfg.sizes) {
+        BenchSize(cfg, perf, n);
+    }
+
+    return 0;
+}
@@ -0,0 +1,96 @@
+/* Exemplo da API C (JPBike.h), compilado como C e ligado à libjpbike: monta uma instância
+ * euclidiana aleatória em memória, resolve com ILS mostrando o progresso e cancela a busca
+ * depois de --cancel-after melhorias (0 = não cancela). */
+
+#include "JPBike.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct progress_state {
+    jpbike_cancel_token* token;
+    int improvements;
+    int cancel_after;
+};
+
+static void on_progress(double cost, double seconds, void* user_data) {
+    struct progress_state* state = (struct progress_state*)user_data;
+    state->improvements++;
+    printf("progresso: custo %.0f em %.3f s\n", cost, seconds);
+    if (state->cancel_after > 0 && state->improvements >= state->cancel_after) {
+        jpbike_cancel(state->token);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int n = 100;
+    int Q = 20;
+    int cancel_after = 0;
+    unsigned int seed = 1;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--n") == 0) n = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--q") == 0) Q = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--seed") == 0) seed = (unsigned int)atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--cancel-after") == 0) cancel_after = atoi(argv[i + 1]);
+        else {
+            printf("Uso: %s [--n N] [--q Q] [--seed S] [--cancel-after K]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    /* Depósito e estações num quadrado 1000 x 1000, demandas em [-Q/2, Q/2] */
+    srand(seed);
+    double* x = malloc(sizeof(double) * (size_t)(n + 1));
+    double* y = malloc(sizeof(double) * (size_t)(n + 1));
+    long long* demands = malloc(sizeof(long long) * (size_t)n);
+    double* costs = malloc(sizeof(double) * (size_t)(n + 1) * (size_t)(n + 1));
+    for (int i = 0; i <= n; ++i) {
+        x[i] = rand() % 1000;
+        y[i] = rand() % 1000;
+    }
+    for (int i = 0; i < n; ++i) {
+        demands[i] = rand() % (Q + 1) - Q / 2;
+    }
+    for (int i = 0; i <= n; ++i) {
+        for (int j = 0; j <= n; ++j) {
+            costs[(size_t)i * (size_t)(n + 1) + (size_t)j] = round(hypot(x[i] - x[j], y[i] - y[j]));
+        }
+    }
+
+    jpbike_options options;
+    jpbike_default_options(&options);
+    options.use_ils = 1;
+    options.seed = seed;
+
+    struct progress_state state = {jpbike_cancel_token_create(), 0, cancel_after};
+    jpbike_result* result = jpbike_solve(n, n, Q, demands, costs, &options, on_progress, &state, state.token);
+    if (!result) {
+        printf("Erro: %s\n", jpbike_last_error());
+        return 1;
+    }
+
+    printf("custo %.0f, %zu rotas, viável: %s%s\n", jpbike_result_cost(result), jpbike_result_num_routes(result),
+           jpbike_result_feasible(result) ? "SIM" : "NÃO", jpbike_result_cancelled(result) ? " (cancelado)" : "");
+    if (!jpbike_result_feasible(result)) {
+        printf("aviso: %s\n", jpbike_last_error());
+    }
+    for (size_t r = 0; r < jpbike_result_num_routes(result); ++r) {
+        const int* nodes;
+        size_t size = jpbike_result_route(result, r, &nodes);
+        printf("rota %zu:", r + 1);
+        for (size_t k = 0; k < size; ++k) {
+            printf(" %d", nodes[k]);
+        }
+        printf("\n");
+    }
+
+    jpbike_result_free(result);
+    jpbike_cancel_token_destroy(state.token);
+    free(x);
+    free(y);
+    free(demands);
+    free(costs);
+    return 0;
+}
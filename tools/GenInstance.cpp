@@ -0,0 +1,102 @@
+// Gerador de instâncias sintéticas no formato texto do JP-Bike ou no formato binário.
+
+#include "Generator.h"
+
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+namespace {
+
+void PrintGenUsage(const char* program_name) {
+    std::cout << "Uso: " << program_name << " --n N --out PATH [opções]" << std::endl;
+    std::cout << "Opções:" << std::endl;
+    std::cout << "  --n N                Número de estações (obrigatório)" << std::endl;
+    std::cout << "  --m M                Número de veículos (padrão: n)" << std::endl;
+    std::cout << "  --q Q                Capacidade dos veículos (padrão: 20)" << std::endl;
+    std::cout << "  --seed N             Semente (padrão: 42)" << std::endl;
+    std::cout << "  --demand TIPO        'uniform', 'balanced' (soma zero) ou 'bimodal' (padrão: uniform)" << std::endl;
+    std::cout << "  --demand-max D       Maior |q_i| (padrão: Q/2)" << std::endl;
+    std::cout << "  --geometry TIPO      'uniform' ou 'clustered' (padrão: uniform)" << std::endl;
+    std::cout << "  --clusters K         Número de clusters (padrão: 8)" << std::endl;
+    std::cout << "  --spread S           Desvio padrão dos clusters (padrão: 40)" << std::endl;
+    std::cout << "  --asymmetry A        Fator de assimetria dos custos em [0, 1) (padrão: 0)" << std::endl;
+    std::cout << "  --out PATH           Arquivo de saída (obrigatório)" << std::endl;
+    std::cout << "  --binary             Grava no formato binário (leitura muito mais rápida)" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    GeneratorParams params;
+    params.n = 0;
+    std::string out_path;
+    bool binary = false;
+
+    for (int i = 1; i < argc; ++i) {
+        bool has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--n") == 0 && has_value) {
+            params.n = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--m") == 0 && has_value) {
+            params.m = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--q") == 0 && has_value) {
+            params.Q = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && has_value) {
+            params.seed = std::stoull(argv[++i]);
+        } else if (strcmp(argv[i], "--demand") == 0 && has_value) {
+            params.demand_dist = argv[++i];
+        } else if (strcmp(argv[i], "--demand-max") == 0 && has_value) {
+            params.demand_max = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--geometry") == 0 && has_value) {
+            params.geometry = argv[++i];
+        } else if (strcmp(argv[i], "--clusters") == 0 && has_value) {
+            params.clusters = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--spread") == 0 && has_value) {
+            params.spread = std::stod(argv[++i]);
+        } else if (strcmp(argv[i], "--asymmetry") == 0 && has_value) {
+            params.asymmetry = std::stod(argv[++i]);
+        } else if (strcmp(argv[i], "--out") == 0 && has_value) {
+            out_path = argv[++i];
+        } else if (strcmp(argv[i], "--binary") == 0) {
+            binary = true;
+        } else if (strcmp(argv[i], "--help") == 0) {
+            PrintGenUsage(argv[0]);
+            return 0;
+        } else {
+            std::cout << "Erro: opção desconhecida ou sem valor: " << argv[i] << std::endl;
+            PrintGenUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (params.n <= 0 || out_path.empty()) {
+        std::cout << "Erro: --n e --out são obrigatórios" << std::endl;
+        PrintGenUsage(argv[0]);
+        return 1;
+    }
+    if (params.demand_dist != "uniform" && params.demand_dist != "balanced" && params.demand_dist != "bimodal") {
+        std::cout << "Erro: --demand deve ser 'uniform', 'balanced' ou 'bimodal'" << std::endl;
+        return 1;
+    }
+    if (params.geometry != "uniform" && params.geometry != "clustered") {
+        std::cout << "Erro: --geometry deve ser 'uniform' ou 'clustered'" << std::endl;
+        return 1;
+    }
+
+    std::unique_ptr<Data> data = GenerateInstance(params);
+
+    std::filesystem::path parent = std::filesystem::path(out_path).parent_path();
+    if (!parent.empty()) {
+        std::filesystem::create_directories(parent);
+    }
+
+    bool ok = binary ? data->writeBinary(out_path) : data->writeText(out_path);
+    if (!ok) {
+        return 1;
+    }
+
+    std::cout << "Instância gerada: " << out_path << " (n=" << params.n << ", Q=" << params.Q
+              << ", seed=" << params.seed << ")" << std::endl;
+    return 0;
+}
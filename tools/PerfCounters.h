@@ -0,0 +1,102 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+// Contadores de hardware via perf_event_open (apenas Linux). Cada contador é aberto
+// isoladamente, de modo que um evento indisponível (VMs, perf_event_paranoid) não
+// invalida os demais; fora do Linux tudo fica indisponível e as leituras retornam 0.
+
+#include <cstdint>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+struct PerfSample {
+    bool has_cycles = false;
+    bool has_instructions = false;
+    bool has_cache_misses = false;
+    uint64_t cycles = 0;
+    uint64_t instructions = 0;
+    uint64_t cache_misses = 0;
+};
+
+class PerfCounters {
+public:
+    PerfCounters() {
+#ifdef __linux__
+        fds[0] = open(PERF_COUNT_HW_CPU_CYCLES);
+        fds[1] = open(PERF_COUNT_HW_INSTRUCTIONS);
+        fds[2] = open(PERF_COUNT_HW_CACHE_MISSES);
+#endif
+    }
+
+    ~PerfCounters() {
+#ifdef __linux__
+        for (int fd : fds) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    [[nodiscard]] bool available() const { return fds[0] >= 0 || fds[1] >= 0 || fds[2] >= 0; }
+
+    void start() {
+#ifdef __linux__
+        for (int fd : fds) {
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+    }
+
+    PerfSample stop() {
+        PerfSample sample;
+#ifdef __linux__
+        uint64_t values[3] = {0, 0, 0};
+        bool ok[3] = {false, false, false};
+        for (int k = 0; k < 3; ++k) {
+            if (fds[k] >= 0) {
+                ioctl(fds[k], PERF_EVENT_IOC_DISABLE, 0);
+                ok[k] = read(fds[k], &values[k], sizeof(uint64_t)) == sizeof(uint64_t);
+            }
+        }
+        sample.has_cycles = ok[0];
+        sample.has_instructions = ok[1];
+        sample.has_cache_misses = ok[2];
+        sample.cycles = values[0];
+        sample.instructions = values[1];
+        sample.cache_misses = values[2];
+#endif
+        return sample;
+    }
+
+private:
+    int fds[3] = {-1, -1, -1};
+
+#ifdef __linux__
+    static int open(uint64_t config) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+#endif
+};
+
+#endif
@@ -0,0 +1,226 @@
+// Varredura de escalabilidade: gera instâncias sintéticas de tamanhos crescentes e mede,
+// fase a fase, tempo e memória (RSS e pico de RSS) em CSV, para localizar onde a
+// complexidade deixa de ser linear.
+
+#include "Construction.h"
+#include "Generator.h"
+#include "ILS.h"
+#include "Instance.h"
+#include "LocalSearch.h"
+#include "ProcStats.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct SweepConfig {
+    std::vector<int> sizes = {100, 200, 500, 1000, 2000, 5000, 10000};
+    GeneratorParams gen;
+    std::string tmp_dir = "/tmp";
+    std::string csv_path;
+    int perturbations = 1000;
+    // Maior n de cada fase; fases ausentes não têm limite
+    std::map<std::string, int> max_n = {
+        {"write_text", 5000}, {"read_text", 5000}, {"insertion", 300}, {"grasp", 300},
+        {"vnd", 500},         {"rvnd", 500},
+    };
+};
+
+const char* const kPhases[] = {"generate", "write_text", "read_text", "write_binary", "read_binary", "neighbors",
+                               "nearest",  "savings",    "insertion", "grasp",        "vnd",         "rvnd",
+                               "perturb"};
+
+class PhaseRecorder {
+public:
+    PhaseRecorder(const SweepConfig& cfg, std::ostream& out) : cfg(cfg), out(out) {
+        peak_resettable = ResetPeakRss();
+        out << "# pico de RSS por fase: " << (peak_resettable ? "sim" : "não (VmHWM acumulado)") << "\n";
+        out << "n,phase,seconds,rss_before_kb,rss_after_kb,peak_rss_kb,peak_delta_kb,result\n";
+    }
+
+    // Executa e registra uma fase; fn devolve um valor de controle (custo, bytes, ...)
+    void run(int n, const std::string& phase, const std::function<double()>& fn) {
+        auto limit = cfg.max_n.find(phase);
+        if (limit != cfg.max_n.end() && n > limit->second) {
+            return;
+        }
+
+        ResetPeakRss();
+        long rss_before = ReadProcStatusKb("VmRSS");
+        auto t0 = std::chrono::steady_clock::now();
+        double result = fn();
+        auto t1 = std::chrono::steady_clock::now();
+        long rss_after = ReadProcStatusKb("VmRSS");
+        long peak = ReadProcStatusKb("VmHWM");
+
+        out << n << "," << phase << "," << std::chrono::duration<double>(t1 - t0).count() << "," << rss_before << ","
+            << rss_after << "," << peak << "," << (peak - rss_before) << "," << result << "\n";
+        out.flush();
+    }
+
+private:
+    const SweepConfig& cfg;
+    std::ostream& out;
+    bool peak_resettable = false;
+};
+
+double FileSize(const std::string& path) {
+    std::error_code ec;
+    auto size = std::filesystem::file_size(path, ec);
+    return ec ? -1.0 : static_cast<double>(size);
+}
+
+double ReadInstance(const std::string& path) {
+    char program[] = "scaling_sweep";
+    char* argv[2] = {program, const_cast<char*>(path.c_str())};
+    Data data(2, argv);
+    data.read();
+    return data.getTravelCost(0, data.getNumStations());
+}
+
+void SweepSize(const SweepConfig& cfg, PhaseRecorder& rec, int n) {
+    GeneratorParams gen = cfg.gen;
+    gen.n = n;
+
+    std::unique_ptr<Data> data_ptr;
+    rec.run(n, "generate", [&] {
+        data_ptr = GenerateInstance(gen);
+        return static_cast<double>(data_ptr->getNumStations());
+    });
+    const Data& data = *data_ptr;
+
+    std::string base = (std::filesystem::path(cfg.tmp_dir) / GeneratedInstanceName(gen)).string();
+    std::string text_path = base + ".txt";
+    std::string binary_path = base + ".bin";
+
+    rec.run(n, "write_text", [&] { return data.writeText(text_path) ? FileSize(text_path) : -1.0; });
+    if (std::filesystem::exists(text_path)) {
+        rec.run(n, "read_text", [&] { return ReadInstance(text_path); });
+        std::filesystem::remove(text_path);
+    }
+    rec.run(n, "write_binary", [&] { return data.writeBinary(binary_path) ? FileSize(binary_path) : -1.0; });
+    if (std::filesystem::exists(binary_path)) {
+        rec.run(n, "read_binary", [&] { return ReadInstance(binary_path); });
+        std::filesystem::remove(binary_path);
+    }
+
+    rec.run(n, "neighbors", [&] { return static_cast<double>(data.getNeighbors(0).size()); });
+
+    std::mt19937 rng(static_cast<unsigned int>(gen.seed));
+    Solution nearest;
+    rec.run(n, "nearest", [&] {
+        nearest = GreedyNearestFeasible(data, rng);
+        return nearest.total_cost;
+    });
+    rec.run(n, "savings", [&] { return ClarkeWrightSavings(data, rng).total_cost; });
+    rec.run(n, "insertion", [&] { return GreedyBestInsertion(data, rng).total_cost; });
+    rec.run(n, "grasp", [&] { return BuildInitial_GRASP(data, rng, 0.3).total_cost; });
+    rec.run(n, "vnd", [&] { return VND(data, nearest, rng).total_cost; });
+    rec.run(n, "rvnd", [&] { return RVND(data, nearest, rng).total_cost; });
+    rec.run(n, "perturb", [&] {
+        Solution perturbed = nearest;
+        for (int k = 0; k < cfg.perturbations; ++k) {
+            ApplyRandomPerturbation(data, perturbed, rng, 2);
+        }
+        return perturbed.total_cost;
+    });
+}
+
+void PrintSweepUsage(const char* program_name) {
+    std::cout << "Uso: " << program_name << " [opções]" << std::endl;
+    std::cout << "Opções:" << std::endl;
+    std::cout << "  --sizes A,B,...      Tamanhos (padrão: 100,200,500,1000,2000,5000,10000)" << std::endl;
+    std::cout << "  --q Q                Capacidade dos veículos (padrão: 20)" << std::endl;
+    std::cout << "  --seed N             Semente das instâncias (padrão: 42)" << std::endl;
+    std::cout << "  --demand TIPO        'uniform', 'balanced' ou 'bimodal' (padrão: uniform)" << std::endl;
+    std::cout << "  --geometry TIPO      'uniform' ou 'clustered' (padrão: uniform)" << std::endl;
+    std::cout << "  --max-n FASE=N       Maior n da fase (padrão: texto 5000, insertion/grasp 300, vnd/rvnd 500)"
+              << std::endl;
+    std::cout << "  --perturbations K    Perturbações na fase perturb (padrão: 1000)" << std::endl;
+    std::cout << "  --tmp DIR            Diretório para os arquivos temporários (padrão: /tmp)" << std::endl;
+    std::cout << "  --csv PATH           Grava o CSV em PATH (padrão: saída padrão)" << std::endl;
+    std::cout << "Fases:";
+    for (const char* phase : kPhases) {
+        std::cout << " " << phase;
+    }
+    std::cout << std::endl;
+}
+
+SweepConfig ParseSweepCLI(int argc, char* argv[]) {
+    SweepConfig cfg;
+    for (int i = 1; i < argc; ++i) {
+        bool has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--sizes") == 0 && has_value) {
+            cfg.sizes.clear();
+            std::stringstream ss(argv[++i]);
+            std::string item;
+            while (std::getline(ss, item, ',')) {
+                cfg.sizes.push_back(std::stoi(item));
+            }
+        } else if (strcmp(argv[i], "--q") == 0 && has_value) {
+            cfg.gen.Q = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && has_value) {
+            cfg.gen.seed = std::stoull(argv[++i]);
+        } else if (strcmp(argv[i], "--demand") == 0 && has_value) {
+            cfg.gen.demand_dist = argv[++i];
+        } else if (strcmp(argv[i], "--geometry") == 0 && has_value) {
+            cfg.gen.geometry = argv[++i];
+        } else if (strcmp(argv[i], "--max-n") == 0 && has_value) {
+            std::string spec = argv[++i];
+            auto eq = spec.find('=');
+            if (eq == std::string::npos) {
+                std::cout << "Erro: --max-n espera FASE=N" << std::endl;
+                exit(1);
+            }
+            cfg.max_n[spec.substr(0, eq)] = std::stoi(spec.substr(eq + 1));
+        } else if (strcmp(argv[i], "--perturbations") == 0 && has_value) {
+            cfg.perturbations = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--tmp") == 0 && has_value) {
+            cfg.tmp_dir = argv[++i];
+        } else if (strcmp(argv[i], "--csv") == 0 && has_value) {
+            cfg.csv_path = argv[++i];
+        } else if (strcmp(argv[i], "--help") == 0) {
+            PrintSweepUsage(argv[0]);
+            exit(0);
+        } else {
+            std::cout << "Erro: opção desconhecida ou sem valor: " << argv[i] << std::endl;
+            PrintSweepUsage(argv[0]);
+            exit(1);
+        }
+    }
+    return cfg;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    SweepConfig cfg = ParseSweepCLI(argc, argv);
+
+    std::ofstream csv_file;
+    if (!cfg.csv_path.empty()) {
+        csv_file.open(cfg.csv_path);
+        if (!csv_file) {
+            std::cout << "Erro: não foi possível criar " << cfg.csv_path << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = cfg.csv_path.empty() ? std::cout : csv_file;
+
+    PhaseRecorder recorder(cfg, out);
+    for (int n : cfg.sizes) {
+        SweepSize(cfg, recorder, n);
+    }
+
+    return 0;
+}
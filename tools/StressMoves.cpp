@@ -0,0 +1,446 @@
+// Teste de estresse dos avaliadores de movimento. Em cada teste sorteia uma instância
+// sintética (tamanho, Q, distribuição de demandas e assimetria da matriz) e:
+//  - compara os testes de viabilidade em O(1) de Feasibility.h com CheckRouteFeasible da
+//    rota alterada, em rotas e posições aleatórias (viáveis ou não);
+//  - roda RVND (com Or-opt-2, Or-opt-1..K, cache intra-rota ou re-sequenciamento), RVND
+//    penalizado, perturbações e path relinking com a verificação diferencial em todos os
+//    movimentos aceitos (Verify.h): a variação prevista por cada avaliador contra SolutionCost;
+//  - aplica relocate, swap, reverse, moveSegment e addRoute aleatórios numa LinkedSolution e
+//    nas mesmas rotas em vetores, comparando toSolution(), rota e posição de cada estação,
+//    custos, cargas e viabilidade, além de verify(), depois de cada movimento.
+// Uma divergência encerra com o teste que a produziu: --first T --trials 1 a repete.
+
+#include "Construction.h"
+#include "Feasibility.h"
+#include "Generator.h"
+#include "ILS.h"
+#include "Instance.h"
+#include "LinkedSolution.h"
+#include "LocalSearch.h"
+#include "PathRelinking.h"
+#include "PenalizedSearch.h"
+#include "Resequence.h"
+#include "Rng.h"
+#include "Verify.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct StressConfig {
+    uint64_t seed = 1;
+    int first = 0;
+    int trials = 200;
+    int kernel_moves = 2000;  // testes de viabilidade sorteados por instância
+    int searches = 20;        // perturbações + RVND por instância
+    int linked_moves = 500;   // movimentos aleatórios na LinkedSolution por instância
+};
+
+const char* const kDemandDists[] = {"uniform", "balanced", "bimodal"};
+
+void PrintStressUsage(const char* program) {
+    std::cout << "Uso: " << program << " [opções]" << std::endl;
+    std::cout << "  --seed S           Semente dos testes (padrão: 1)" << std::endl;
+    std::cout << "  --first T          Índice do primeiro teste (padrão: 0)" << std::endl;
+    std::cout << "  --trials N         Número de testes (padrão: 200)" << std::endl;
+    std::cout << "  --kernel-moves M   Testes de viabilidade sorteados por instância (padrão: 2000)" << std::endl;
+    std::cout << "  --searches K       Perturbações seguidas de busca local por instância (padrão: 20)" << std::endl;
+    std::cout << "  --linked-moves L   Movimentos aleatórios na LinkedSolution por instância (padrão: 500)" << std::endl;
+}
+
+StressConfig ParseStressCLI(int argc, char* argv[]) {
+    StressConfig cfg;
+    for (int i = 1; i < argc; ++i) {
+        bool has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--seed") == 0 && has_value) {
+            cfg.seed = std::stoull(argv[++i]);
+        } else if (strcmp(argv[i], "--first") == 0 && has_value) {
+            cfg.first = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--trials") == 0 && has_value) {
+            cfg.trials = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--kernel-moves") == 0 && has_value) {
+            cfg.kernel_moves = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--searches") == 0 && has_value) {
+            cfg.searches = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--linked-moves") == 0 && has_value) {
+            cfg.linked_moves = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--help") == 0) {
+            PrintStressUsage(argv[0]);
+            exit(0);
+        } else {
+            std::cout << "Erro: opção desconhecida ou sem valor: " << argv[i] << std::endl;
+            PrintStressUsage(argv[0]);
+            exit(1);
+        }
+    }
+    return cfg;
+}
+
+int Uniform(std::mt19937& rng, int lo, int hi) {
+    return std::uniform_int_distribution<int>(lo, hi)(rng);
+}
+
+// Rota com estações sorteadas (sem repetição), sem garantia de viabilidade
+Route RandomRoute(const Data& data, std::mt19937& rng, int size) {
+    std::vector<int> stations(data.getNumStations());
+    for (int i = 0; i < data.getNumStations(); ++i) {
+        stations[i] = i + 1;
+    }
+    std::shuffle(stations.begin(), stations.end(), rng);
+    Route route;
+    route.nodes.push_back(0);
+    route.nodes.insert(route.nodes.end(), stations.begin(), stations.begin() + size);
+    route.nodes.push_back(0);
+    return route;
+}
+
+// Interrompe na primeira divergência entre a previsão e a rota alterada
+class KernelChecker {
+public:
+    KernelChecker(const StressConfig& cfg, int trial) : cfg(cfg), trial(trial) {}
+
+    void expect(const char* kernel, bool predicted, const Data& data, const Route& changed) {
+        checked++;
+        if (predicted == CheckRouteFeasible(data, changed).ok) {
+            return;
+        }
+        std::cout << "Erro: " << kernel << " previu " << (predicted ? "viável" : "inviável") << " para a rota";
+        for (int v : changed.nodes) {
+            std::cout << " " << v;
+        }
+        std::cout << " (Q = " << data.getVehicleCapacity() << ")" << std::endl;
+        std::cout << "Reproduza com: --seed " << cfg.seed << " --first " << trial << " --trials 1" << std::endl;
+        exit(1);
+    }
+
+    long long checked = 0;
+
+private:
+    const StressConfig& cfg;
+    int trial;
+};
+
+void FuzzKernels(const Data& data, std::mt19937& rng, int moves, KernelChecker& check) {
+    const long long Q = static_cast<long long>(data.getVehicleCapacity());
+    const int n = data.getNumStations();
+    RouteLoadProfile profile;
+
+    for (int move = 0; move < moves; ++move) {
+        Route route = RandomRoute(data, rng, Uniform(rng, 2, std::max(2, n - 1)));
+        BuildLoadProfile(data, route, profile);
+        const size_t k = route.nodes.size() - 2;
+        size_t pos = static_cast<size_t>(Uniform(rng, 1, static_cast<int>(k)));
+        size_t last = static_cast<size_t>(Uniform(rng, static_cast<int>(pos), static_cast<int>(k)));
+
+        switch (Uniform(rng, 0, 5)) {
+            case 0: {
+                // Estação que não está na rota, em qualquer posição 1..k+1
+                std::vector<int> outside;
+                std::vector<char> in_route(n + 1, 0);
+                for (int v : route.nodes) in_route[v] = 1;
+                for (int v = 1; v <= n; ++v) {
+                    if (!in_route[v]) outside.push_back(v);
+                }
+                if (outside.empty()) break;
+                int v = outside[Uniform(rng, 0, static_cast<int>(outside.size()) - 1)];
+                size_t at = static_cast<size_t>(Uniform(rng, 1, static_cast<int>(k) + 1));
+                bool predicted = CanInsertAt(profile, at, NodeDemand(data, v), Q);
+                bool may = MayShiftSuffix(LoadWindowOf(data, route), NodeDemand(data, v), Q);
+                route.nodes.insert(route.nodes.begin() + static_cast<long>(at), v);
+                check.expect("CanInsertAt", predicted, data, route);
+                if (predicted) check.expect("MayShiftSuffix", may, data, route);
+                break;
+            }
+            case 1: {
+                bool predicted = CanRemoveAt(profile, pos, NodeDemand(data, route.nodes[pos]), Q);
+                route.nodes.erase(route.nodes.begin() + static_cast<long>(pos));
+                check.expect("CanRemoveAt", predicted, data, route);
+                break;
+            }
+            case 2: {
+                long long demand = profile.prefix[last] - profile.prefix[pos - 1];
+                bool predicted = CanRemoveSegment(profile, pos, last, demand, Q);
+                route.nodes.erase(route.nodes.begin() + static_cast<long>(pos),
+                                  route.nodes.begin() + static_cast<long>(last) + 1);
+                check.expect("CanRemoveSegment", predicted, data, route);
+                break;
+            }
+            case 3: {
+                int v = Uniform(rng, 1, n);
+                if (std::find(route.nodes.begin(), route.nodes.end(), v) != route.nodes.end()) break;
+                long long delta = NodeDemand(data, v) - NodeDemand(data, route.nodes[pos]);
+                bool predicted = CanReplaceAt(profile, pos, delta, Q);
+                bool may = MayShiftSuffix(LoadWindowOf(data, route), delta, Q);
+                route.nodes[pos] = v;
+                check.expect("CanReplaceAt", predicted, data, route);
+                if (predicted) check.expect("MayShiftSuffix", may, data, route);
+                break;
+            }
+            case 4: {
+                bool predicted = CanReverseSegment(profile, pos, last, Q);
+                std::reverse(route.nodes.begin() + static_cast<long>(pos),
+                             route.nodes.begin() + static_cast<long>(last) + 1);
+                check.expect("CanReverseSegment", predicted, data, route);
+                break;
+            }
+            case 5: {
+                // Trecho [pos..last] reinserido (na mesma ordem) em outra posição da rota restante
+                std::vector<int> block(route.nodes.begin() + static_cast<long>(pos),
+                                       route.nodes.begin() + static_cast<long>(last) + 1);
+                Route reduced = route;
+                reduced.nodes.erase(reduced.nodes.begin() + static_cast<long>(pos),
+                                    reduced.nodes.begin() + static_cast<long>(last) + 1);
+                RouteLoadProfile reduced_profile;
+                BuildLoadProfile(data, reduced, reduced_profile);
+                Route block_route;
+                block_route.nodes.push_back(0);
+                block_route.nodes.insert(block_route.nodes.end(), block.begin(), block.end());
+                block_route.nodes.push_back(0);
+                size_t at = static_cast<size_t>(Uniform(rng, 1, static_cast<int>(reduced.nodes.size()) - 1));
+                bool predicted = CanInsertSegmentAt(reduced_profile, at, LoadWindowOf(data, block_route), Q);
+                reduced.nodes.insert(reduced.nodes.begin() + static_cast<long>(at), block.begin(), block.end());
+                check.expect("CanInsertSegmentAt", predicted, data, reduced);
+                break;
+            }
+        }
+    }
+}
+
+// Movimentos aleatórios numa LinkedSolution e nas mesmas rotas em vetores (só estações); depois
+// de cada um compara a solução, a rota e a posição de cada estação, resumos e verify()
+long long StressLinked(const Data& data, std::mt19937& rng, int moves, const StressConfig& cfg, int trial) {
+    const int n = data.getNumStations();
+    std::vector<int> stations(n);
+    for (int i = 0; i < n; ++i) {
+        stations[i] = i + 1;
+    }
+    std::shuffle(stations.begin(), stations.end(), rng);
+    std::vector<std::vector<int>> reference(Uniform(rng, 1, std::max(1, n / 2)));
+    for (int v : stations) {
+        reference[Uniform(rng, 0, static_cast<int>(reference.size()) - 1)].push_back(v);
+    }
+    Solution initial;
+    for (const std::vector<int>& stations_of_route : reference) {
+        Route route;
+        route.nodes.push_back(0);
+        route.nodes.insert(route.nodes.end(), stations_of_route.begin(), stations_of_route.end());
+        route.nodes.push_back(0);
+        initial.routes.push_back(std::move(route));
+    }
+    LinkedSolution linked(data, initial);
+
+    std::string move = "construção";
+    auto fail = [&](const std::string& what) {
+        std::cout << "Erro: LinkedSolution diverge após " << move << ": " << what << std::endl;
+        std::cout << "Reproduza com: --seed " << cfg.seed << " --first " << trial << " --trials 1" << std::endl;
+        exit(1);
+    };
+    auto locate = [&](int v, int& r, int& i) {
+        for (r = 0; r < static_cast<int>(reference.size()); ++r) {
+            auto it = std::find(reference[r].begin(), reference[r].end(), v);
+            if (it != reference[r].end()) {
+                i = static_cast<int>(it - reference[r].begin());
+                return;
+            }
+        }
+    };
+    // Ponto de inserção sorteado: sentinela da rota t (início) ou uma de suas estações
+    auto random_after = [&](int& t, int& at) {
+        t = Uniform(rng, 0, static_cast<int>(reference.size()) - 1);
+        at = Uniform(rng, 0, static_cast<int>(reference[t].size()));
+        return at == 0 ? linked.depotOf(t) : reference[t][at - 1];
+    };
+    auto compare = [&]() {
+        std::string error;
+        if (!linked.verify(&error)) {
+            fail("verify: " + error);
+        }
+        Solution actual = linked.toSolution();
+        if (actual.routes.size() != reference.size() || linked.numRoutes() != static_cast<int>(reference.size())) {
+            fail("número de rotas");
+        }
+        Solution expected;
+        for (int r = 0; r < static_cast<int>(reference.size()); ++r) {
+            Route route;
+            route.nodes.push_back(0);
+            route.nodes.insert(route.nodes.end(), reference[r].begin(), reference[r].end());
+            route.nodes.push_back(0);
+            if (actual.routes[r].nodes != route.nodes) {
+                fail("rota " + std::to_string(r) + " difere da referência");
+            }
+            long long load = 0;
+            for (int i = 0; i < static_cast<int>(reference[r].size()); ++i) {
+                int v = reference[r][i];
+                load += NodeDemand(data, v);
+                if (linked.routeOf(v) != r || linked.position(v) != i + 1) {
+                    fail("estação " + std::to_string(v) + " em rota " + std::to_string(linked.routeOf(v)) +
+                         ", posição " + std::to_string(linked.position(v)) + "; esperado rota " + std::to_string(r) +
+                         ", posição " + std::to_string(i + 1));
+                }
+            }
+            const LinkedSolution::RouteSummary& summary = linked.summary(r);
+            if (summary.size != static_cast<int>(reference[r].size()) || summary.load != load) {
+                fail("resumo da rota " + std::to_string(r));
+            }
+            if (linked.routeFeasible(r) != CheckRouteFeasible(data, route).ok) {
+                fail("viabilidade da rota " + std::to_string(r));
+            }
+            expected.routes.push_back(std::move(route));
+        }
+        double cost = SolutionCost(data, expected);
+        if (std::abs(linked.totalCost() - cost) > 1e-6 * std::max(1.0, std::abs(cost))) {
+            fail("custo total " + std::to_string(linked.totalCost()) + ", recalculado " + std::to_string(cost));
+        }
+    };
+
+    compare();
+    for (int m = 0; m < moves; ++m) {
+        int v = Uniform(rng, 1, n);
+        int r = 0;
+        int i = 0;
+        locate(v, r, i);
+        int kind = Uniform(rng, 0, 20);
+
+        if (kind == 20) {
+            move = "addRoute()";
+            linked.addRoute();
+            reference.emplace_back();
+        } else if (kind % 4 == 0) {
+            int t = 0;
+            int at = 0;
+            int after = random_after(t, at);
+            if (after == v) continue;
+            move = "relocate(" + std::to_string(v) + ", " + std::to_string(after) + ")";
+            linked.relocate(v, after);
+            reference[r].erase(reference[r].begin() + i);
+            int insert_at = 0;
+            if (!linked.isDepot(after)) {
+                locate(after, t, insert_at);
+                insert_at++;
+            }
+            reference[t].insert(reference[t].begin() + insert_at, v);
+        } else if (kind % 4 == 1) {
+            int u = Uniform(rng, 1, n);
+            int ru = 0;
+            int iu = 0;
+            locate(u, ru, iu);
+            move = "swap(" + std::to_string(u) + ", " + std::to_string(v) + ")";
+            linked.swap(u, v);
+            std::swap(reference[ru][iu], reference[r][i]);
+        } else if (kind % 4 == 2) {
+            int j = Uniform(rng, i, static_cast<int>(reference[r].size()) - 1);
+            move = "reverse(" + std::to_string(v) + ", " + std::to_string(reference[r][j]) + ")";
+            linked.reverse(v, reference[r][j]);
+            std::reverse(reference[r].begin() + i, reference[r].begin() + j + 1);
+        } else {
+            int j = Uniform(rng, i, static_cast<int>(reference[r].size()) - 1);
+            int last = reference[r][j];
+            std::vector<int> segment(reference[r].begin() + i, reference[r].begin() + j + 1);
+            reference[r].erase(reference[r].begin() + i, reference[r].begin() + j + 1);
+            // Sorteado depois de tirar o trecho: o ponto de inserção nunca cai dentro dele
+            int t = 0;
+            int at = 0;
+            int after = random_after(t, at);
+            bool reversed = Uniform(rng, 0, 1) == 1;
+            move = "moveSegment(" + std::to_string(v) + ", " + std::to_string(last) + ", " + std::to_string(after) +
+                   (reversed ? ", invertido)" : ")");
+            linked.moveSegment(v, last, after, reversed);
+            if (reversed) {
+                std::reverse(segment.begin(), segment.end());
+            }
+            reference[t].insert(reference[t].begin() + at, segment.begin(), segment.end());
+        }
+        compare();
+    }
+    return moves;
+}
+
+// Buscas com verificação em 100% dos movimentos aceitos (VerifyMove aborta na divergência)
+void StressSearches(const Data& data, std::mt19937& rng, int searches) {
+    Solution a = RVND(data, BuildInitial_GRASP(data, rng, 0.3), rng);
+    Solution b = RVND(data, BuildInitial_GRASP(data, rng, 0.5), rng);
+    double lambda = InitialPenalty(data);
+    RouteOptimaCache cache(size_t{1} << 16, Uniform(rng, 1, 4));
+    SequenceMemo memo;
+
+    for (int s = 1; s <= searches; ++s) {
+        SetVerifyContext(0, s);
+        Solution perturbed = a;
+        const double before = perturbed.total_cost;
+        double predicted = 0.0;
+        const char* strategy = ApplyRandomPerturbation(data, perturbed, rng, Uniform(rng, 1, 4), &predicted);
+        if (!strategy) continue;
+        VerifyMove(data, perturbed, strategy, before, predicted);
+
+        Solution penalized = PenalizedRVND(data, perturbed, lambda * std::uniform_real_distribution<double>(0.05, 2.0)(rng), rng);
+        ProjectToFeasible(data, penalized, rng);
+        Solution improved;
+        switch (s % 4) {
+            case 0: improved = RVND(data, perturbed, rng); break;
+            case 1:
+                improved = RVNDWith(data, perturbed, rng,
+                                    OrOptPipeline(RelocateNeighborhood{}, SwapNeighborhood{}, TwoOptNeighborhood{},
+                                                  OrOptNeighborhood{Uniform(rng, 1, 4)}));
+                break;
+            case 2:
+                improved = RVNDWith(data, perturbed, rng,
+                                    CachedOrOptPipeline(RelocateNeighborhood{}, SwapNeighborhood{},
+                                                        CachedTwoOptNeighborhood{cache}, CachedOrOptNeighborhood{cache}));
+                break;
+            default:
+                improved = RVNDWith(data, perturbed, rng,
+                                    ResequencePipeline(RelocateNeighborhood{}, SwapNeighborhood{},
+                                                       ResequenceNeighborhood{memo, &cache}));
+                break;
+        }
+        if (improved.total_cost < a.total_cost) {
+            a = std::move(improved);
+        }
+    }
+    SetVerifyContext(0, 0);
+    (void)PathRelink(data, b, a, rng);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    StressConfig cfg = ParseStressCLI(argc, argv);
+
+    long long kernel_checks = 0;
+    long long linked_moves = 0;
+    for (int trial = cfg.first; trial < cfg.first + cfg.trials; ++trial) {
+        std::mt19937 rng = MakeStreamRng(cfg.seed, static_cast<uint64_t>(trial));
+
+        GeneratorParams gen;
+        gen.n = Uniform(rng, 6, 60);
+        gen.Q = Uniform(rng, 2, 30);
+        gen.seed = StreamSeed(cfg.seed, static_cast<uint64_t>(trial));
+        gen.demand_dist = kDemandDists[Uniform(rng, 0, 2)];
+        gen.demand_max = Uniform(rng, 1, gen.Q);
+        gen.geometry = Uniform(rng, 0, 1) ? "clustered" : "uniform";
+        gen.asymmetry = Uniform(rng, 0, 1) ? 0.5 : 0.0;
+        std::unique_ptr<Data> data = GenerateInstance(gen);
+
+        KernelChecker check(cfg, trial);
+        FuzzKernels(*data, rng, cfg.kernel_moves, check);
+        kernel_checks += check.checked;
+        linked_moves += StressLinked(*data, rng, cfg.linked_moves, cfg, trial);
+
+        EnableVerification(1.0, static_cast<unsigned int>(cfg.seed),
+                           std::string(argv[0]) + " --seed " + std::to_string(cfg.seed) + " --first " +
+                               std::to_string(trial) + " --trials 1");
+        StressSearches(*data, rng, cfg.searches);
+    }
+
+    std::cout << cfg.trials << " instâncias: " << kernel_checks << " testes de viabilidade, " << linked_moves
+              << " movimentos na LinkedSolution e " << VerifiedMoves()
+              << " movimentos aceitos conferidos, nenhuma divergência" << std::endl;
+    return 0;
+}